@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+
+"""Runs a fixed matrix of experiments and compares their performance against a baseline."""
+
+import argparse
+import json
+import math
+import os
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+DIRNAME = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR = os.path.normpath(os.path.join(DIRNAME, '..'))
+
+CMD = os.environ.get('CMD') or os.path.join(DATA_DIR, '..', 'build', 'spexplain')
+
+# name, model, dataset, no. samples from the beginning of the dataset
+MODELS_DATASETS = [
+    ('heart_attack', 'models/heart_attack/heart_attack-50.nnet', 'datasets/heart_attack/heart_attack_short.csv', 20),
+    ('obesity', 'models/obesity/obesity-10-20-10.nnet', 'datasets/obesity/obesity_short.csv', 20),
+    ('mnist-200', 'models/mnist/mnist-200.nnet', 'datasets/mnist/mnist_quick.csv', 5),
+]
+
+STRATEGIES = ['abductive', 'trial n 4', 'ucore', 'itp']
+
+# metric -> whether higher values are better
+METRICS = {
+    'samples_per_s': True,
+    'checks': False,
+    'p50_s': False,
+    'p95_s': False,
+    'max_s': False,
+    'peak_rss_mb': False,
+}
+
+
+def experiments(filter_regex):
+    for name, model, dataset, n_samples in MODELS_DATASETS:
+        for spec in STRATEGIES:
+            exp_name = '{}/{}'.format(name, spec.replace(' ', '_'))
+            if filter_regex and not re.search(filter_regex, exp_name):
+                continue
+            yield exp_name, model, dataset, n_samples, spec
+
+
+def percentile(values, q):
+    # Nearest-rank
+    values = sorted(values)
+    rank = max(1, math.ceil(q * len(values)))
+    return values[rank - 1]
+
+
+def run_once(model, dataset, n_samples, spec, extra_args):
+    with tempfile.TemporaryDirectory(prefix='spexplain-perf-') as tmp_dir:
+        records_fn = os.path.join(tmp_dir, 'records.jsonl')
+        cmd = [CMD, os.path.join(DATA_DIR, model), os.path.join(DATA_DIR, dataset), spec,
+               '--quiet', '--verifier', 'opensmt', '--max-samples', str(n_samples),
+               '--output-explanations', os.path.join(tmp_dir, 'phi.txt'),
+               '--output-records', records_fn] + extra_args
+
+        start = time.monotonic()
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL)
+        # Unlike `subprocess.run`, it provides the resource usage of just this child
+        _, status, rusage = os.wait4(proc.pid, 0)
+        wall = time.monotonic() - start
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        if proc.returncode != 0:
+            raise RuntimeError('Command failed with exit code {}: {}'.format(proc.returncode, ' '.join(cmd)))
+
+        with open(records_fn) as f:
+            records = [json.loads(line) for line in f if line.strip()]
+
+    if not records:
+        raise RuntimeError('No records produced by: {}'.format(' '.join(cmd)))
+
+    times = [rec['time'] for rec in records]
+    return {
+        'samples': len(records),
+        'timeouts': sum(1 for rec in records if rec['timeout']),
+        'wall_s': wall,
+        'samples_per_s': len(records) / wall,
+        'checks': sum(rec['checks'] for rec in records),
+        'p50_s': percentile(times, 0.5),
+        'p95_s': percentile(times, 0.95),
+        'max_s': max(times),
+        # Kilobytes on Linux
+        'peak_rss_mb': rusage.ru_maxrss / 1024,
+    }
+
+
+def run_experiment(model, dataset, n_samples, spec, repeat, extra_args):
+    runs = [run_once(model, dataset, n_samples, spec, extra_args) for _ in range(repeat)]
+    # The median over the repetitions is less sensitive to noise
+    result = {key: statistics.median(run[key] for run in runs) for key in runs[0]}
+    result['samples'] = runs[0]['samples']
+    return result
+
+
+def print_results(results, baseline, threshold):
+    header = '{:<28} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>9}'.format(
+        'experiment', 'samples', 'samples/s', '#checks', 'p50 [s]', 'p95 [s]', 'max [s]', 'RSS [MB]')
+    print(header)
+    print('-' * len(header))
+
+    regressions = []
+    for exp_name, res in results.items():
+        print('{:<28} {:>8} {:>10.3f} {:>10} {:>10.4f} {:>10.4f} {:>10.4f} {:>9.1f}'.format(
+            exp_name, res['samples'], res['samples_per_s'], int(res['checks']), res['p50_s'], res['p95_s'],
+            res['max_s'], res['peak_rss_mb']))
+
+        base = baseline.get(exp_name) if baseline else None
+        if base is None:
+            continue
+
+        for metric, higher_is_better in METRICS.items():
+            old, new = base.get(metric), res[metric]
+            if not old:
+                continue
+            change = (new - old) / old
+            worse = -change if higher_is_better else change
+            if worse > threshold:
+                regressions.append((exp_name, metric, old, new, change))
+
+    if baseline is None:
+        return regressions
+
+    missing = sorted(set(baseline) - set(results))
+    if missing:
+        print('\nNot run from the baseline: {}'.format(', '.join(missing)))
+
+    if regressions:
+        print('\nRegressions beyond {:.0f}%:'.format(threshold * 100))
+        for exp_name, metric, old, new, change in regressions:
+            print('{:<28} {:<14} {:>12.4f} -> {:>12.4f} ({:+.1f}%)'.format(exp_name, metric, old, new, change * 100))
+    else:
+        print('\nNo regressions beyond {:.0f}%'.format(threshold * 100))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-b', '--baseline', help='JSON file with the baseline results to compare against')
+    parser.add_argument('-s', '--save', help='Store the results into the JSON file (e.g., as a new baseline)')
+    parser.add_argument('-t', '--threshold', type=float, default=10,
+                        help='Relative change in %% that is reported as a regression (default: %(default)s)')
+    parser.add_argument('-r', '--repeat', type=int, default=3,
+                        help='No. runs of each experiment, the median is taken (default: %(default)s)')
+    parser.add_argument('-f', '--filter', help='Run only the experiments whose names match the regex')
+    parser.add_argument('args', nargs=argparse.REMAINDER, help='Additional arguments forwarded to spexplain')
+    opts = parser.parse_args()
+
+    if opts.repeat < 1:
+        parser.error('the no. runs must be positive')
+
+    baseline = None
+    if opts.baseline:
+        with open(opts.baseline) as f:
+            baseline = json.load(f)['results']
+
+    extra_args = opts.args[1:] if opts.args[:1] == ['--'] else opts.args
+
+    results = {}
+    for exp_name, model, dataset, n_samples, spec in experiments(opts.filter):
+        print('Running {} ...'.format(exp_name), file=sys.stderr, flush=True)
+        results[exp_name] = run_experiment(model, dataset, n_samples, spec, opts.repeat, extra_args)
+
+    regressions = print_results(results, baseline, opts.threshold / 100)
+
+    if opts.save:
+        with open(opts.save, 'w') as f:
+            json.dump({'cmd': CMD, 'args': extra_args, 'repeat': opts.repeat, 'results': results}, f, indent=2)
+            f.write('\n')
+
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
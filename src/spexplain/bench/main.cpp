@@ -0,0 +1,314 @@
+#include <spexplain/framework/Config.h>
+#include <spexplain/framework/Framework.h>
+#include <spexplain/network/Dataset.h>
+#include <spexplain/network/Network.h>
+
+#include <verifiers/opensmt/OpenSMTVerifier.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <getopt.h>
+
+#ifndef SPEXPLAIN_DATA_DIR
+#define SPEXPLAIN_DATA_DIR "data"
+#endif
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double>;
+
+struct Model {
+    std::string_view name;
+    std::string_view modelFn;
+    std::string_view datasetFn;
+};
+
+// Relative to the data directory
+constexpr Model models[] = {
+    {"toy", "models/toy.nnet", "datasets/toy.csv"},
+    {"heart_attack", "models/heart_attack/heart_attack-50.nnet", "datasets/heart_attack/heart_attack_quick.csv"},
+    {"obesity", "models/obesity/obesity-10-20-10.nnet", "datasets/obesity/obesity_quick.csv"},
+    {"mnist-200", "models/mnist/mnist-200.nnet", "datasets/mnist/mnist_quick.csv"},
+};
+
+constexpr std::string_view strategySpecs[] = {"abductive", "trial n 4", "ucore", "itp"};
+
+struct Options {
+    std::string dataDir{SPEXPLAIN_DATA_DIR};
+    std::size_t repetitions{10};
+    std::size_t warmups{1};
+    std::string filter{};
+};
+
+// Prevents the compiler from optimizing away the computation of the value
+volatile std::size_t sink{};
+
+class Bench {
+public:
+    // Returns the measured duration, which allows to exclude the setup of each repetition
+    using Run = std::function<Duration()>;
+
+    explicit Bench(Options const & opts) : options{opts} {}
+
+    void printHead(std::ostream & os) const {
+        os << std::left << std::setw(40) << "benchmark" << std::right;
+        for (char const * col : {"median", "mean", "stddev", "min", "max"}) {
+            os << ' ' << std::setw(11) << col;
+        }
+        os << ' ' << std::setw(7) << "cv" << "  [ms]\n";
+    }
+
+    void operator()(std::ostream & os, std::string const & name, Run const & run) const {
+        if (not options.filter.empty() and name.find(options.filter) == std::string::npos) { return; }
+
+        for (std::size_t i = 0; i < options.warmups; ++i) {
+            run();
+        }
+
+        std::vector<double> timesMs;
+        timesMs.reserve(options.repetitions);
+        for (std::size_t i = 0; i < options.repetitions; ++i) {
+            timesMs.push_back(run().count() * 1000);
+        }
+
+        printRow(os, name, timesMs);
+    }
+
+    // Measures the whole call
+    static Run timed(std::function<void()> f) {
+        return [f = std::move(f)] {
+            auto const start = Clock::now();
+            f();
+            return Duration{Clock::now() - start};
+        };
+    }
+
+protected:
+    static void printRow(std::ostream & os, std::string const & name, std::vector<double> timesMs) {
+        assert(not timesMs.empty());
+        std::ranges::sort(timesMs);
+
+        std::size_t const n = timesMs.size();
+        double const median = (n % 2 == 1) ? timesMs[n / 2] : (timesMs[n / 2 - 1] + timesMs[n / 2]) / 2;
+        double const mean = std::accumulate(timesMs.begin(), timesMs.end(), 0.0) / n;
+        double variance = 0;
+        for (double t : timesMs) {
+            variance += (t - mean) * (t - mean);
+        }
+        if (n > 1) { variance /= (n - 1); }
+        double const stddev = std::sqrt(variance);
+        double const cv = (mean > 0) ? (stddev / mean) : 0;
+
+        auto const defaultFlags = os.flags();
+        auto const defaultPrecision = os.precision();
+
+        os << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3);
+        for (double value : {median, mean, stddev, timesMs.front(), timesMs.back()}) {
+            os << ' ' << std::setw(11) << value;
+        }
+        os << ' ' << std::setw(6) << std::setprecision(1) << (cv * 100) << '%' << std::endl;
+
+        os.flags(defaultFlags);
+        os.precision(defaultPrecision);
+    }
+
+    Options const & options;
+};
+
+// The same classification constraint as asserted when explaining
+void assertClassification(xai::verifiers::Verifier & verifier, spexplain::Network const & network,
+                          spexplain::Network::Classification::Label label) {
+    if (network.nClasses() > 2) {
+        verifier.addClassificationConstraint(label, 0);
+        return;
+    }
+
+    constexpr spexplain::Float threshold = 0.015625f;
+    auto const outputLayerIndex = network.nLayers() - 1;
+    if (label == 1) {
+        verifier.addUpperBound(outputLayerIndex, 0, -threshold);
+    } else {
+        verifier.addLowerBound(outputLayerIndex, 0, threshold);
+    }
+}
+
+void benchModel(std::ostream & os, Bench const & bench, Options const & options, Model const & model) {
+    using spexplain::Network;
+
+    std::string const modelFn = options.dataDir + '/' + std::string{model.modelFn};
+    std::string const datasetFn = options.dataDir + '/' + std::string{model.datasetFn};
+    std::string const prefix = std::string{model.name} + '/';
+
+    bench(os, prefix + "fromNNetFile", Bench::timed([&] {
+              auto networkPtr = Network::fromNNetFile(modelFn);
+              sink = networkPtr->nLayers();
+          }));
+
+    auto const networkPtr = Network::fromNNetFile(modelFn);
+    auto const & network = *networkPtr;
+
+    bench(os, prefix + "Dataset", Bench::timed([&] {
+              Network::Dataset data{network, datasetFn};
+              sink = data.size();
+          }));
+
+    Network::Dataset data{network, datasetFn};
+    assert(data.size() > 0);
+
+    bench(os, prefix + "Network::operator()", Bench::timed([&] {
+              std::size_t labelSum = 0;
+              for (std::size_t idx = 0; idx < data.size(); ++idx) {
+                  labelSum += network(data.getSample(idx)).classification.label;
+              }
+              sink = labelSum;
+          }));
+
+    // A fresh verifier each time, since the verifier keeps the encoded network across resets
+    bench(os, prefix + "OpenSMTVerifier::loadModel", [&] {
+        xai::verifiers::OpenSMTVerifier freshVerifier;
+        freshVerifier.init();
+        auto const start = Clock::now();
+        freshVerifier.loadModel(network);
+        return Duration{Clock::now() - start};
+    });
+
+    xai::verifiers::OpenSMTVerifier verifier;
+    verifier.init();
+
+    // The per-sample setup when the encoded network is reused, to compare with the fresh load above
+    verifier.loadModel(network);
+    bench(os, prefix + "OpenSMTVerifier::loadModel(cached)", [&] {
+        verifier.reset();
+        auto const start = Clock::now();
+        verifier.loadModel(network);
+        return Duration{Clock::now() - start};
+    });
+    verifier.reset();
+
+    // The check with the whole sample fixed, which is the first check of the abductive strategy
+    auto const sample = data.getSample(0);
+    auto const label = network(sample).classification.label;
+    bench(os, prefix + "OpenSMTVerifier::check", [&] {
+        verifier.loadModel(network);
+        verifier.push();
+        assertClassification(verifier, network, label);
+        for (std::size_t var = 0; var < network.nInputs(); ++var) {
+            verifier.addEquality(0, var, sample[var]);
+        }
+        auto const start = Clock::now();
+        [[maybe_unused]] auto const answer = verifier.check();
+        Duration const duration = Clock::now() - start;
+        assert(answer == xai::verifiers::Verifier::Answer::UNSAT);
+        verifier.pop();
+        verifier.reset();
+        return duration;
+    });
+
+    // Just the first sample, including the overhead of a run of the framework
+    auto const outputFn = (std::filesystem::temp_directory_path() / "spexplain-bench.phi.txt").string();
+    for (std::string_view spec : strategySpecs) {
+        spexplain::Framework::Config config;
+        config.beQuiet();
+        config.setVerifierName("opensmt");
+        config.setExplanationsFileName(outputFn);
+        config.setMaxSamples(1);
+
+        std::istringstream specIss{std::string{spec}};
+        spexplain::Framework framework{config, Network::fromNNetFile(modelFn), specIss};
+        Network::Dataset frameworkData{framework.getNetwork(), datasetFn};
+
+        bench(os, prefix + "sample/" + std::string{spec}, Bench::timed([&] {
+                  auto explanations = framework.explain(frameworkData);
+                  sink = explanations.size();
+              }));
+    }
+    std::filesystem::remove(outputFn);
+    std::filesystem::remove(outputFn + ".journal");
+}
+
+void printUsage(char * const argv[], std::ostream & os = std::cout) {
+    os << "USAGE: " << argv[0] << " [<options>]\n";
+    os << "Runs the microbenchmarks over the models in the data directory\n";
+    os << "OPTIONS:\n";
+    os << "    -h          Prints this help message and exits\n";
+    os << "    -d <dir>    The data directory (default: " << SPEXPLAIN_DATA_DIR << ")\n";
+    os << "    -n <int>    No. measured repetitions (default: 10)\n";
+    os << "    -w <int>    No. warm-up repetitions (default: 1)\n";
+    os << "    -f <str>    Run only the benchmarks the names of which contain the string\n";
+}
+
+std::optional<int> getOpts(int argc, char * argv[], Options & options) {
+    while (true) {
+        int c = getopt(argc, argv, ":hd:n:w:f:");
+        if (c == -1) { break; }
+
+        switch (c) {
+            case 'h':
+                printUsage(argv);
+                return 0;
+            case 'd':
+                options.dataDir = optarg;
+                break;
+            case 'n':
+                options.repetitions = std::stoull(optarg);
+                if (options.repetitions == 0) {
+                    std::cerr << "Option '-n': expected a positive no. repetitions\n";
+                    return 1;
+                }
+                break;
+            case 'w':
+                options.warmups = std::stoull(optarg);
+                break;
+            case 'f':
+                options.filter = optarg;
+                break;
+            case ':':
+                std::cerr << "Option '-" << char(optopt) << "' requires an argument\n";
+                printUsage(argv, std::cerr);
+                return 1;
+            default:
+                std::cerr << "Unrecognized option: '-" << char(optopt) << "'\n";
+                printUsage(argv, std::cerr);
+                return 1;
+        }
+    }
+
+    if (optind < argc) {
+        std::cerr << "Unexpected argument: " << argv[optind] << '\n';
+        printUsage(argv, std::cerr);
+        return 1;
+    }
+
+    return std::nullopt;
+}
+} // namespace
+
+int main(int argc, char * argv[]) try {
+    Options options;
+    if (auto optRet = getOpts(argc, argv, options)) { return *optRet; }
+
+    Bench const bench{options};
+    bench.printHead(std::cout);
+    for (auto const & model : models) {
+        benchModel(std::cout, bench, options, model);
+    }
+
+    return 0;
+} catch (std::exception const & e) {
+    std::cerr << "Terminated with an exception:\n" << e.what() << std::endl;
+    return 1;
+}
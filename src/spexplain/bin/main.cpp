@@ -62,6 +62,7 @@ void printUsageLongOptRow(std::ostream & os, std::string_view longOpt, std::stri
 void printUsage(char * const argv[], std::ostream & os = std::cout) {
     using spexplain::Framework;
     using spexplain::expand::opensmt::InterpolationStrategy;
+    using spexplain::expand::opensmt::UnsatCoreAbductiveStrategy;
     using spexplain::expand::opensmt::UnsatCoreStrategy;
 
     assert(argv);
@@ -70,10 +71,18 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
     os << "USAGE: " << cmd;
     os << " [<action>] <args> [<options>]\n";
 
-    os << "ACTIONS: [explain] dump-psi\n";
+    os << "ACTIONS: [explain] serve lookup dump-psi convert\n";
     os << "ARGS:\n";
     os << "\t explain:\t <nn_model_fn> <dataset_fn> [<exp_strategies_spec>]\n";
+    os << "\t serve:\t\t <nn_model_fn> <socket_fn> [<exp_strategies_spec>]\n";
+    os << "\t lookup:\t <nn_model_fn> <explanations_fn> <dataset_fn>\n";
     os << "\t dump-psi:\t <nn_model_fn>\n";
+    os << "\t convert:\t <nn_model_fn> <binary_nn_model_fn>\n";
+    os << "Models are accepted either in the .nnet format or in the binary format produced by convert\n";
+    os << "Serve requests: '<value>[,<value>]...[;<smtlib2_explanation>]' per line,\n";
+    os << "each response is the explanation followed by an empty line (or 'error: <msg>')\n";
+    os << "Lookup prints '<line>:<label>' of each explanation that covers a sample (or 'none'),\n";
+    os << "by default into " << spexplain::Framework::Config::defaultLookupFileName << '\n';
 
     os << "STRATEGIES SPEC: '<spec1>[; <spec2>]...'\n";
     os << "Each spec: '<name>[ <param>[, <param>]...]'\n";
@@ -81,8 +90,10 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
     //+ template by the strategy and move the params to the classes as well
     printUsageStrategyRow(os, Framework::Expand::NopStrategy::name());
     printUsageStrategyRow(os, Framework::Expand::AbductiveStrategy::name());
+    printUsageStrategyRow(os, Framework::Expand::BisectAbductiveStrategy::name());
+    printUsageStrategyRow(os, UnsatCoreAbductiveStrategy::name(), {"min"});
     //+ also include 'vars'
-    printUsageStrategyRow(os, Framework::Expand::TrialAndErrorStrategy::name(), {"n <int>"}, {"n 4"});
+    printUsageStrategyRow(os, Framework::Expand::TrialAndErrorStrategy::name(), {"n <int>", "parallel"}, {"n 4"});
     printUsageStrategyRow(os, UnsatCoreStrategy::name(), {"interval", "min", "vars x<i>..."});
     printUsageStrategyRow(os, InterpolationStrategy::name(),
                           {"weak", "strong", "weaker", "stronger", "bweak", "bstrong", "aweak", "astrong", "aweaker",
@@ -111,6 +122,9 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
     printUsageLongOptRow(os, "output-stats");
     printUsageOptRow(os, 's', "<file>", "Output statistics into the file");
     printUsageLongOptRow(os, "output-times", "<file>", "Output runtime splits into the file");
+    printUsageLongOptRow(os, "output-records", "<file>", "Output a JSON record per sample into the file");
+    printUsageLongOptRow(os, "profile", "", "Output the times of the individual phases into the statistics");
+    printUsageLongOptRow(os, "trace", "<file>", "Output the timeline of the phases into the file (implies --profile)");
     printUsageLongOptRow(os, "verbose");
     printUsageOptRow(os, 'v', "", "Run in verbose mode");
     printUsageLongOptRow(os, "quiet");
@@ -131,6 +145,24 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
                          "Only process sample points that match the given filter");
     printUsageLongOptRow(os, "time-limit-per");
     printUsageOptRow(os, 't', "<ms>", "Time limit per explanation in miliseconds");
+    printUsageLongOptRow(os, "threads");
+    printUsageOptRow(os, 'j', "<int>", "Explain samples in parallel using the given no. threads");
+    printUsageLongOptRow(os, "schedule", "order|margin",
+                         "In parallel, start with samples in the given order or with the smallest output margin");
+    printUsageLongOptRow(os, "bound-propagation", "interval|symbolic",
+                         "Prove checks by bound propagation if possible, and fix the phases of stable ReLUs"
+                         " within the checked boxes (not with itp or ucore)");
+    printUsageLongOptRow(os, "no-assumptions", "",
+                         "Assert the explanation anew within each check instead of assuming its guarded bounds");
+    printUsageLongOptRow(os, "reuse-explanations", "verify|trust",
+                         "Reuse the explanation of an earlier sample of the same class whose box contains the sample,"
+                         " either re-verified or trusted");
+    printUsageLongOptRow(os, "resume", "",
+                         "Skip the samples completed by an interrupted run with the same options,"
+                         " according to the journal next to the explanations file, and append to its outputs");
+    printUsageLongOptRow(os, "split-classification", "<int>",
+                         "Check each competing class as a separate query, skipping the classes ruled out by bound"
+                         " propagation, using the given no. verifiers in parallel (not with itp or ucore)");
 
     os << "\nEXAMPLES:\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv\n";
@@ -138,7 +170,14 @@ void printUsage(char * const argv[], std::ostream & os = std::cout) {
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'ucore interval, min' -RS -e toy.phi.txt\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'itp aweaker, bstrong; ucore'\n";
     os << cmd << " data/models/toy.nnet data/datasets/toy.csv 'trial n 3' -n2 -s stats.txt\n";
+    os << cmd << " data/models/mnist/mnist-200.nnet data/datasets/mnist/mnist_short.csv abductive -j8\n";
+    os << cmd
+       << " data/models/mnist/mnist-200.nnet data/datasets/mnist/mnist_short.csv abductive -V opensmt"
+          " --bound-propagation symbolic\n";
+    os << cmd << " serve data/models/mnist/mnist-200.nnet /tmp/spexplain.sock abductive -j4 -I\n";
+    os << cmd << " lookup data/models/toy.nnet toy.phi.txt data/datasets/toy.csv -j4\n";
     os << cmd << " dump-psi data/models/toy.nnet\n";
+    os << cmd << " convert data/models/mnist/mnist-200.nnet mnist-200.nnetb\n";
 
     os.flush();
 }
@@ -151,6 +190,15 @@ std::optional<int> getOpts(int argc, char * argv[], spexplain::Framework::Config
     constexpr int formatLongOpt = 2;
     constexpr int filterLongOpt = 3;
     constexpr int outputTimesLongOpt = 4;
+    constexpr int scheduleLongOpt = 5;
+    constexpr int boundPropagationLongOpt = 6;
+    constexpr int noAssumptionsLongOpt = 7;
+    constexpr int reuseExplanationsLongOpt = 8;
+    constexpr int splitClassificationLongOpt = 9;
+    constexpr int resumeLongOpt = 10;
+    constexpr int outputRecordsLongOpt = 11;
+    constexpr int profileLongOpt = 12;
+    constexpr int traceLongOpt = 13;
 
     struct ::option longOptions[] = {{"help", no_argument, nullptr, 'h'},
                                      {"verifier", required_argument, nullptr, 'V'},
@@ -158,6 +206,7 @@ std::optional<int> getOpts(int argc, char * argv[], spexplain::Framework::Config
                                      {"output-explanations", required_argument, nullptr, 'e'},
                                      {"output-stats", required_argument, nullptr, 's'},
                                      {"output-times", required_argument, &selectedLongOpt, outputTimesLongOpt},
+                                     {"output-records", required_argument, &selectedLongOpt, outputRecordsLongOpt},
                                      {"verbose", no_argument, nullptr, 'v'},
                                      {"quiet", no_argument, nullptr, 'q'},
                                      // {"version", no_argument, &selectedLongOpt, versionLongOpt},
@@ -168,9 +217,21 @@ std::optional<int> getOpts(int argc, char * argv[], spexplain::Framework::Config
                                      {"samples", required_argument, nullptr, 'i'},
                                      {"filter-samples", required_argument, &selectedLongOpt, filterLongOpt},
                                      {"time-limit-per", required_argument, nullptr, 't'},
+                                     {"threads", required_argument, nullptr, 'j'},
+                                     {"schedule", required_argument, &selectedLongOpt, scheduleLongOpt},
+                                     {"bound-propagation", required_argument, &selectedLongOpt,
+                                      boundPropagationLongOpt},
+                                     {"no-assumptions", no_argument, &selectedLongOpt, noAssumptionsLongOpt},
+                                     {"reuse-explanations", required_argument, &selectedLongOpt,
+                                      reuseExplanationsLongOpt},
+                                     {"split-classification", required_argument, &selectedLongOpt,
+                                      splitClassificationLongOpt},
+                                     {"resume", no_argument, &selectedLongOpt, resumeLongOpt},
+                                     {"profile", no_argument, &selectedLongOpt, profileLongOpt},
+                                     {"trace", required_argument, &selectedLongOpt, traceLongOpt},
                                      {0, 0, 0, 0}};
 
-    std::string optString = ":hV:E:e:s:vqRSIrn:i:t:";
+    std::string optString = ":hV:E:e:s:vqRSIrn:i:t:j:";
 
     while (true) {
         int optIndex = 0;
@@ -179,11 +240,14 @@ std::optional<int> getOpts(int argc, char * argv[], spexplain::Framework::Config
 
         switch (c) {
             case 0: {
-                std::string_view optargStr{optarg};
+                std::string_view optargStr = optarg ? optarg : "";
                 switch (selectedLongOpt) {
                     case outputTimesLongOpt:
                         config.setTimesFileName(optarg);
                         break;
+                    case outputRecordsLongOpt:
+                        config.setRecordsFileName(optarg);
+                        break;
                     case formatLongOpt:
                         if (optargStr == "smtlib2") {
                             config.printIntervalExplanationsInSmtLib2Format();
@@ -194,6 +258,51 @@ std::optional<int> getOpts(int argc, char * argv[], spexplain::Framework::Config
                             config.printIntervalExplanationsInBoundFormat();
                         }
                         break;
+                    case scheduleLongOpt:
+                        if (optargStr == "margin") {
+                            config.scheduleSamplesByMargin();
+                        } else {
+                            assert(optargStr == "order");
+                        }
+                        break;
+                    case boundPropagationLongOpt:
+                        if (optargStr == "symbolic") {
+                            config.setBoundPropagation(spexplain::Network::BoundPropagation::Type::symbolic);
+                        } else {
+                            assert(optargStr == "interval");
+                            config.setBoundPropagation(spexplain::Network::BoundPropagation::Type::interval);
+                        }
+                        break;
+                    case noAssumptionsLongOpt:
+                        config.checkWithoutAssumptions();
+                        break;
+                    case reuseExplanationsLongOpt:
+                        if (optargStr == "trust") {
+                            config.reuseExplanations(false);
+                        } else {
+                            assert(optargStr == "verify");
+                            config.reuseExplanations();
+                        }
+                        break;
+                    case resumeLongOpt:
+                        config.resume();
+                        break;
+                    case profileLongOpt:
+                        config.profile();
+                        break;
+                    case traceLongOpt:
+                        config.setTraceFileName(optarg);
+                        break;
+                    case splitClassificationLongOpt: {
+                        auto const n = std::stoull(std::string{optargStr});
+                        if (n == 0) {
+                            std::cerr << "Option '--split-classification': expected a positive no. verifiers\n";
+                            printUsage(argv, std::cerr);
+                            return 1;
+                        }
+                        config.splitClassification(n);
+                        break;
+                    }
                     case filterLongOpt:
                         std::optional<bool> optCorrectnessFilter{};
                         if (optargStr.starts_with("in")) {
@@ -302,6 +411,16 @@ std::optional<int> getOpts(int argc, char * argv[], spexplain::Framework::Config
                 config.setTimeLimitPerExplanation(limit);
                 break;
             }
+            case 'j': {
+                auto const n = std::stoull(optarg);
+                if (n == 0) {
+                    std::cerr << "Option '-" << char(c) << "': expected a positive no. threads\n";
+                    printUsage(argv, std::cerr);
+                    return 1;
+                }
+                config.setThreads(n);
+                break;
+            }
             case ':':
                 std::cerr << "Option: '-" << char(optopt) << "' requires an argument\n\n";
                 printUsage(argv, std::cerr);
@@ -328,7 +447,7 @@ int mainExplain(int argc, char * argv[], int i, int nArgs) {
     }
 
     std::string_view const nnModelFn = argv[++i];
-    auto networkPtr = spexplain::Network::fromNNetFile(nnModelFn);
+    auto networkPtr = spexplain::Network::fromFile(nnModelFn);
     assert(networkPtr);
 
     std::string_view const datasetFn = argv[++i];
@@ -344,7 +463,7 @@ int mainExplain(int argc, char * argv[], int i, int nArgs) {
     std::istringstream strategiesSpecIss{std::string{strategiesSpec}};
     spexplain::Framework framework{config, std::move(networkPtr), strategiesSpecIss};
 
-    auto dataset = spexplain::Network::Dataset{framework.getNetwork(), datasetFn};
+    auto dataset = spexplain::Network::Dataset{framework.getNetwork(), datasetFn, config.getThreads()};
     std::size_t const size = dataset.size();
 
     spexplain::Explanations explanations =
@@ -354,11 +473,81 @@ int mainExplain(int argc, char * argv[], int i, int nArgs) {
     return 0;
 }
 
+int mainServe(int argc, char * argv[], int i, int nArgs) {
+    assert(nArgs >= 1);
+
+    constexpr int minArgs = 2;
+    if (nArgs < minArgs) {
+        std::cerr << "Expected at least " << minArgs << " arguments for serve, got: " << nArgs << '\n';
+        printUsage(argv, std::cerr);
+        return 1;
+    }
+
+    std::string_view const nnModelFn = argv[++i];
+    auto networkPtr = spexplain::Network::fromFile(nnModelFn);
+    assert(networkPtr);
+
+    std::string_view const socketFn = argv[++i];
+
+    std::string_view const strategiesSpec = (i + 1 < argc) ? argv[++i] : "";
+
+    spexplain::Framework::Config config;
+
+    if (auto optRet = getOpts(argc, argv, config)) { return *optRet; }
+
+    std::istringstream strategiesSpecIss{std::string{strategiesSpec}};
+    spexplain::Framework framework{config, std::move(networkPtr), strategiesSpecIss};
+
+    framework.serve(socketFn);
+
+    return 0;
+}
+
+int mainLookup(int argc, char * argv[], int i, int nArgs) {
+    assert(nArgs >= 1);
+
+    constexpr int minArgs = 3;
+    if (nArgs < minArgs) {
+        std::cerr << "Expected at least " << minArgs << " arguments for lookup, got: " << nArgs << '\n';
+        printUsage(argv, std::cerr);
+        return 1;
+    }
+
+    std::string_view const nnModelFn = argv[++i];
+    auto networkPtr = spexplain::Network::fromFile(nnModelFn);
+    assert(networkPtr);
+
+    std::string_view const explanationsFn = argv[++i];
+    std::string_view const datasetFn = argv[++i];
+
+    spexplain::Framework::Config config;
+
+    if (auto optRet = getOpts(argc, argv, config)) { return *optRet; }
+
+    // Do not let the default output overwrite the looked up explanations
+    if (not config.explanationsFileNameIsSet()) {
+        config.setExplanationsFileName(spexplain::Framework::Config::defaultLookupFileName);
+    }
+    if (config.getExplanationsFileName() == explanationsFn) {
+        throw std::invalid_argument{"The output file must differ from the looked up explanations file: " +
+                                    std::string{explanationsFn}};
+    }
+
+    spexplain::Framework framework{config};
+    framework.setNetwork(std::move(networkPtr));
+
+    auto dataset = spexplain::Network::Dataset{framework.getNetwork(), datasetFn, config.getThreads()};
+
+    framework.lookup(explanationsFn, dataset);
+
+    return 0;
+}
+
 int mainDumpPsi(int argc, char * argv[], int i, [[maybe_unused]] int nArgs) {
     assert(nArgs >= 1);
 
     std::string_view const nnModelFn = argv[++i];
-    auto networkPtr = spexplain::Network::fromNNetFile(nnModelFn);
+    auto networkPtr = spexplain::Network::fromFile(nnModelFn);
     assert(networkPtr);
 
     spexplain::Framework::Config config;
@@ -374,6 +563,31 @@ int mainDumpPsi(int argc, char * argv[], int i, [[maybe_unused]] int nArgs) {
 
     return 0;
 }
+
+int mainConvert(int argc, char * argv[], int i, int nArgs) {
+    assert(nArgs >= 1);
+
+    constexpr int minArgs = 2;
+    if (nArgs < minArgs) {
+        std::cerr << "Expected at least " << minArgs << " arguments for convert, got: " << nArgs << '\n';
+        printUsage(argv, std::cerr);
+        return 1;
+    }
+
+    std::string_view const nnModelFn = argv[++i];
+    auto networkPtr = spexplain::Network::fromFile(nnModelFn);
+    assert(networkPtr);
+
+    std::string_view const binaryNnModelFn = argv[++i];
+
+    spexplain::Framework::Config config;
+
+    if (auto optRet = getOpts(argc, argv, config)) { return *optRet; }
+
+    networkPtr->writeBinaryFile(binaryNnModelFn);
+
+    return 0;
+}
 } // namespace
 
 int main(int argc, char * argv[]) try {
@@ -397,7 +611,10 @@ int main(int argc, char * argv[]) try {
     --nArgs;
 
     if (maybeAction == "explain") { return mainExplain(argc, argv, i, nArgs); }
+    if (maybeAction == "serve") { return mainServe(argc, argv, i, nArgs); }
+    if (maybeAction == "lookup") { return mainLookup(argc, argv, i, nArgs); }
     if (maybeAction == "dump-psi") { return mainDumpPsi(argc, argv, i, nArgs); }
+    if (maybeAction == "convert") { return mainConvert(argc, argv, i, nArgs); }
 
     // Assume the default action
     --i;
@@ -1,13 +1,25 @@
 #include "Bound.h"
 
+#include "Print.h"
+
 #include <ostream>
 
 namespace spexplain {
 void Bound::printRegular(std::ostream & os) const {
-    std::visit([&](auto & t) { os << t.getSymbol() << ' ' << value; }, op);
+    std::visit(
+        [&](auto & t) {
+            os << t.getSymbol() << ' ';
+            printFloat(os, value);
+        },
+        op);
 }
 
 void Bound::printReverse(std::ostream & os) const {
-    std::visit([&](auto & t) { os << value << ' ' << t.getReverseSymbol(); }, op);
+    std::visit(
+        [&](auto & t) {
+            printFloat(os, value);
+            os << ' ' << t.getReverseSymbol();
+        },
+        op);
 }
 } // namespace spexplain
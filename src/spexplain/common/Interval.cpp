@@ -1,5 +1,7 @@
 #include "Interval.h"
 
+#include "Print.h"
+
 #include <ostream>
 
 namespace spexplain {
@@ -12,6 +14,10 @@ void Interval::intersect(Interval && rhs) {
 }
 
 void Interval::print(std::ostream & os) const {
-    os << '[' << getLower() << ',' << getUpper() << ']';
+    os << '[';
+    printFloat(os, getLower());
+    os << ',';
+    printFloat(os, getUpper());
+    os << ']';
 }
 } // namespace spexplain
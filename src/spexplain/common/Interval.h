@@ -54,6 +54,8 @@ public:
 
     constexpr Float size() const { return getUpper() - getLower(); }
 
+    constexpr bool contains(Float val) const { return val >= getLower() and val <= getUpper(); }
+
     // It assumes that they have at least some overlap
     void intersect(Interval &&);
 
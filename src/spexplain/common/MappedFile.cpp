@@ -0,0 +1,47 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace spexplain {
+MappedFile::MappedFile(std::string_view filename) {
+    std::string const filenameStr{filename};
+    int const fd = ::open(filenameStr.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::ifstream::failure{"Could not open file " + filenameStr}; }
+
+    struct ::stat st{};
+    if (::fstat(fd, &st) != 0) {
+        int const err = errno;
+        ::close(fd);
+        throw std::system_error{err, std::generic_category(), "Could not stat file " + filenameStr};
+    }
+
+    _size = st.st_size;
+    // Mapping of zero length is not allowed
+    if (_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void * mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int const err = errno;
+    // The mapping is kept even after closing the descriptor
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::system_error{err, std::generic_category(), "Could not map file " + filenameStr};
+    }
+
+    ptr = mapped;
+}
+
+MappedFile::~MappedFile() {
+    if (ptr) { ::munmap(ptr, _size); }
+}
+} // namespace spexplain
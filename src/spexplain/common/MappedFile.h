@@ -0,0 +1,31 @@
+#ifndef SPEXPLAIN_MAPPEDFILE_H
+#define SPEXPLAIN_MAPPEDFILE_H
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+namespace spexplain {
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(std::string_view filename);
+    ~MappedFile();
+    MappedFile(MappedFile const &) = delete;
+    MappedFile & operator=(MappedFile const &) = delete;
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return size() == 0; }
+
+    // Page-aligned
+    std::byte const * data() const { return static_cast<std::byte const *>(ptr); }
+
+    std::span<std::byte const> bytes() const { return {data(), size()}; }
+
+protected:
+    void * ptr{};
+    std::size_t _size{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_MAPPEDFILE_H
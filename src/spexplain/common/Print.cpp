@@ -4,6 +4,8 @@
 #include <common/StringConv.h>
 #include <common/numbers/FastRational.h>
 
+#include <charconv>
+#include <ios>
 #include <ostream>
 #include <string>
 
@@ -21,6 +23,25 @@ namespace {
     }
 } // namespace
 
+void printFloat(std::ostream & os, Float value) {
+    constexpr auto nonDefaultFlags =
+        std::ios_base::floatfield | std::ios_base::showpoint | std::ios_base::showpos | std::ios_base::uppercase;
+    if ((os.flags() & nonDefaultFlags) or os.width() != 0) {
+        os << value;
+        return;
+    }
+
+    // Same as the default format of streams, i.e. %g with the precision of the stream
+    char buf[128];
+    auto const precision = static_cast<int>(os.precision());
+    auto const [end, ec] = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, precision);
+    if (ec != std::errc{}) {
+        os << value;
+        return;
+    }
+    os.write(buf, end - buf);
+}
+
 void printSmtLib2AsRational(std::ostream & os, Float val) {
     auto const rat = floatToFastRational(val);
     os << rat;
@@ -32,6 +32,9 @@ inline auto smtLib2Format(T const & arg) {
     return PrintSmtLib2Proxy<T>{arg};
 }
 
+// Equivalent to `os << value`, but avoids the locale machinery of the stream in the common case
+void printFloat(std::ostream &, Float);
+
 void printSmtLib2AsRational(std::ostream &, Float);
 } // namespace spexplain
 
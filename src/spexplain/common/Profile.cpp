@@ -0,0 +1,212 @@
+#include "Profile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+namespace spexplain {
+void Profile::Histogram::add(std::uint64_t durationNs) {
+    ++count;
+    totalNs += durationNs;
+    maxNs = std::max(maxNs, durationNs);
+    std::size_t const bucket = std::bit_width(durationNs);
+    ++buckets[std::min(bucket, nBuckets - 1)];
+}
+
+void Profile::Histogram::merge(Histogram const & rhs) {
+    count += rhs.count;
+    totalNs += rhs.totalNs;
+    maxNs = std::max(maxNs, rhs.maxNs);
+    for (std::size_t bucket = 0; bucket < nBuckets; ++bucket) {
+        buckets[bucket] += rhs.buckets[bucket];
+    }
+}
+
+std::uint64_t Profile::Histogram::quantileNs(double q) const {
+    assert(q >= 0 and q <= 1);
+    if (count == 0) { return 0; }
+
+    auto const rank = static_cast<std::uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    std::uint64_t cumulative = 0;
+    for (std::size_t bucket = 0; bucket < nBuckets; ++bucket) {
+        cumulative += buckets[bucket];
+        if (cumulative < rank) { continue; }
+        // The bucket contains the durations with the bit width equal to its index
+        std::uint64_t const upper = (bucket == 0) ? 0 : ((std::uint64_t{1} << bucket) - 1);
+        return std::min(upper, maxNs);
+    }
+    return maxNs;
+}
+
+void Profile::enable(bool tracing_) {
+    std::lock_guard lock{registryMtx};
+    for (auto * dataPtr : registry) {
+        dataPtr->histograms.clear();
+        dataPtr->events.clear();
+    }
+    finishedHistograms.clear();
+    for (auto & events : finishedEvents) {
+        events.clear();
+    }
+
+    epoch = Clock::now();
+    tracing = tracing_;
+    enabled = true;
+}
+
+void Profile::disable() {
+    enabled = false;
+    tracing = false;
+}
+
+Profile::ThreadData & Profile::getThreadData() {
+    struct Holder {
+        ~Holder() {
+            if (dataPtr) { finishThread(*dataPtr); }
+        }
+
+        std::unique_ptr<ThreadData> dataPtr{};
+    };
+
+    thread_local Holder holder{};
+    auto & dataPtr = holder.dataPtr;
+    if (not dataPtr) {
+        std::lock_guard lock{registryMtx};
+        std::size_t tid;
+        if (freeTids.empty()) {
+            tid = nextTid++;
+            finishedEvents.emplace_back();
+        } else {
+            tid = freeTids.back();
+            freeTids.pop_back();
+        }
+        dataPtr = std::make_unique<ThreadData>(ThreadData{.tid = tid});
+        registry.push_back(dataPtr.get());
+    }
+    return *dataPtr;
+}
+
+void Profile::finishThread(ThreadData & data) {
+    std::lock_guard lock{registryMtx};
+    mergeHistograms(finishedHistograms, data);
+    auto & events = finishedEvents[data.tid];
+    events.insert(events.end(), data.events.begin(), data.events.end());
+    freeTids.push_back(data.tid);
+    std::erase(registry, &data);
+}
+
+void Profile::mergeHistograms(NamedHistograms & histograms, ThreadData const & data) {
+    for (auto const & [name, hist] : data.histograms) {
+        std::string_view const nameSv{name};
+        auto it = std::ranges::find(histograms, nameSv, &NamedHistograms::value_type::first);
+        if (it == histograms.end()) { it = histograms.insert(histograms.end(), {nameSv, Histogram{}}); }
+        it->second.merge(hist);
+    }
+}
+
+void Profile::record(char const * name, Clock::time_point start, Clock::time_point finish) {
+    auto & data = getThreadData();
+    auto const durationNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count());
+
+    auto & histograms = data.histograms;
+    auto it = std::ranges::find(histograms, name, &std::pair<char const *, Histogram>::first);
+    if (it == histograms.end()) { it = histograms.insert(it, {name, Histogram{}}); }
+    it->second.add(durationNs);
+
+    if (not isTracing()) { return; }
+
+    // The scope may have started before enabling
+    auto const startNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::max(start, epoch) - epoch).count());
+    data.events.push_back({.name = name, .startNs = startNs, .durationNs = durationNs});
+}
+
+void Profile::printStats(std::ostream & os) {
+    std::lock_guard lock{registryMtx};
+
+    NamedHistograms histograms = finishedHistograms;
+    for (auto const * dataPtr : registry) {
+        mergeHistograms(histograms, *dataPtr);
+    }
+
+    std::ranges::sort(histograms, std::ranges::greater{},
+                      [](auto const & pair) { return pair.second.totalNs; });
+
+    auto const defaultFlags = os.flags();
+    auto const defaultPrecision = os.precision();
+
+    auto const printMs = [&os](std::uint64_t ns) { os << ' ' << std::setw(11) << (static_cast<double>(ns) / 1e6); };
+
+    os << "Profile of the phases [ms]:\n";
+    os << std::left << std::setw(24) << "phase" << std::right << ' ' << std::setw(9) << "#calls";
+    for (char const * col : {"total", "mean", "p50", "p90", "p99", "max"}) {
+        os << ' ' << std::setw(11) << col;
+    }
+    os << '\n';
+
+    os << std::fixed << std::setprecision(3);
+    for (auto const & [name, hist] : histograms) {
+        os << std::left << std::setw(24) << name << std::right << ' ' << std::setw(9) << hist.count;
+        printMs(hist.totalNs);
+        printMs(hist.totalNs / hist.count);
+        printMs(hist.quantileNs(0.5));
+        printMs(hist.quantileNs(0.9));
+        printMs(hist.quantileNs(0.99));
+        printMs(hist.maxNs);
+        os << '\n';
+    }
+
+    os.flags(defaultFlags);
+    os.precision(defaultPrecision);
+}
+
+void Profile::printTrace(std::ostream & os) {
+    std::lock_guard lock{registryMtx};
+
+    auto const defaultFlags = os.flags();
+    auto const defaultPrecision = os.precision();
+
+    // Microseconds with the precision of nanoseconds
+    auto const printUs = [&os](std::uint64_t ns) { os << std::fixed << std::setprecision(3) << (ns / 1e3); };
+
+    std::vector<ThreadData const *> runningData(nextTid, nullptr);
+    for (auto const * dataPtr : registry) {
+        runningData[dataPtr->tid] = dataPtr;
+    }
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (std::size_t tid = 0; tid < nextTid; ++tid) {
+        // The events of the finished threads precede those of the running thread with the same tid
+        auto const & events = finishedEvents[tid];
+        auto const * dataPtr = runningData[tid];
+        if (events.empty() and (not dataPtr or dataPtr->events.empty())) { continue; }
+
+        if (not first) { os << ','; }
+        first = false;
+        os << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid
+           << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+        auto const printEvents = [&](std::vector<Event> const & events_) {
+            for (auto const & [name, startNs, durationNs] : events_) {
+                os << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid << ",\"ts\":";
+                printUs(startNs);
+                os << ",\"dur\":";
+                printUs(durationNs);
+                os << '}';
+            }
+        };
+        printEvents(events);
+        if (dataPtr) { printEvents(dataPtr->events); }
+    }
+    os << "\n]}\n";
+
+    os.flags(defaultFlags);
+    os.precision(defaultPrecision);
+}
+} // namespace spexplain
@@ -0,0 +1,111 @@
+#ifndef SPEXPLAIN_PROFILE_H
+#define SPEXPLAIN_PROFILE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace spexplain {
+// Scoped timers of the phases of the computation, aggregated per thread into histograms
+// and optionally also recorded as a timeline of events
+// When disabled, a scope costs just a single relaxed atomic load
+// The names of the phases are not copied, they must outlive the profile (e.g. string literals)
+class Profile {
+public:
+    class Scope;
+
+    // Discards anything measured before
+    static void enable(bool tracing = false);
+    static void disable();
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static bool isTracing() { return tracing.load(std::memory_order_relaxed); }
+
+    // Aggregated over all the threads, must not be called while measuring
+    static void printStats(std::ostream &);
+    // In the Chrome trace-event format (viewable e.g. in Perfetto), must not be called while measuring
+    static void printTrace(std::ostream &);
+
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    // Buckets by powers of two of nanoseconds
+    struct Histogram {
+        static constexpr std::size_t nBuckets = 64;
+
+        void add(std::uint64_t durationNs);
+        void merge(Histogram const &);
+
+        // Approximate, the upper bound of the bucket, at most the maximum
+        std::uint64_t quantileNs(double q) const;
+
+        std::uint64_t count{};
+        std::uint64_t totalNs{};
+        std::uint64_t maxNs{};
+        std::array<std::uint64_t, nBuckets> buckets{};
+    };
+
+    struct Event {
+        char const * name;
+        std::uint64_t startNs;
+        std::uint64_t durationNs;
+    };
+
+    struct ThreadData {
+        std::size_t tid;
+        // Only a few phases, linear search is fast enough
+        std::vector<std::pair<char const *, Histogram>> histograms{};
+        std::vector<Event> events{};
+    };
+
+    // The same names from different threads may not share the pointer
+    using NamedHistograms = std::vector<std::pair<std::string_view, Histogram>>;
+
+    static ThreadData & getThreadData();
+    // Merges the data of a finishing thread into the aggregates and releases its tid
+    static void finishThread(ThreadData &);
+
+    static void mergeHistograms(NamedHistograms &, ThreadData const &);
+
+    static void record(char const * name, Clock::time_point start, Clock::time_point finish);
+
+    static inline std::atomic<bool> enabled{};
+    static inline std::atomic<bool> tracing{};
+
+    static inline Clock::time_point epoch{};
+
+    static inline std::mutex registryMtx{};
+    // Only of the running threads, s.t. short-lived threads do not accumulate
+    static inline std::vector<ThreadData *> registry{};
+    static inline NamedHistograms finishedHistograms{};
+    // Indexed by the tids
+    static inline std::vector<std::vector<Event>> finishedEvents{};
+    // The tids are reused by later threads, hence there are only as many as the maximum of concurrent threads
+    static inline std::vector<std::size_t> freeTids{};
+    static inline std::size_t nextTid{};
+};
+
+class Profile::Scope {
+public:
+    explicit Scope(char const * name_) : name{name_} {
+        if (isEnabled()) { start = Clock::now(); }
+    }
+    ~Scope() {
+        if (start != Clock::time_point{}) { record(name, start, Clock::now()); }
+    }
+    Scope(Scope const &) = delete;
+    Scope & operator=(Scope const &) = delete;
+
+protected:
+    char const * name;
+    Clock::time_point start{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_PROFILE_H
@@ -0,0 +1,80 @@
+#include "ThreadPool.h"
+
+#include <cassert>
+#include <utility>
+
+namespace spexplain {
+ThreadPool::ThreadPool(std::size_t size_) {
+    assert(size_ > 0);
+    threads.reserve(size_ - 1);
+    for (std::size_t idx = 1; idx < size_; ++idx) {
+        threads.emplace_back([this, idx] { work(idx); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{mtx};
+        stopping = true;
+    }
+    startCv.notify_all();
+    // Before the synchronization primitives are destroyed
+    threads.clear();
+}
+
+void ThreadPool::run(std::size_t n, Job const & job) {
+    assert(n <= size());
+    if (n == 0) { return; }
+
+    {
+        std::lock_guard lock{mtx};
+        assert(nRunning == 0);
+        jobPtr = &job;
+        jobSize = n;
+        nRunning = n - 1;
+        exceptionPtr = nullptr;
+        ++generation;
+    }
+    if (n > 1) { startCv.notify_all(); }
+
+    std::exception_ptr callerExceptionPtr{};
+    try {
+        job(0);
+    } catch (...) {
+        callerExceptionPtr = std::current_exception();
+    }
+
+    std::unique_lock lock{mtx};
+    finishCv.wait(lock, [this] { return nRunning == 0; });
+    jobPtr = nullptr;
+
+    if (callerExceptionPtr) { std::rethrow_exception(callerExceptionPtr); }
+    if (exceptionPtr) { std::rethrow_exception(std::exchange(exceptionPtr, nullptr)); }
+}
+
+void ThreadPool::work(std::size_t idx) {
+    std::size_t lastGeneration{};
+    while (true) {
+        Job const * job;
+        {
+            std::unique_lock lock{mtx};
+            startCv.wait(lock, [&] { return stopping or generation != lastGeneration; });
+            if (stopping) { return; }
+            lastGeneration = generation;
+            if (idx >= jobSize) { continue; }
+            job = jobPtr;
+        }
+
+        std::exception_ptr jobExceptionPtr{};
+        try {
+            (*job)(idx);
+        } catch (...) {
+            jobExceptionPtr = std::current_exception();
+        }
+
+        std::lock_guard lock{mtx};
+        if (jobExceptionPtr and not exceptionPtr) { exceptionPtr = std::move(jobExceptionPtr); }
+        if (--nRunning == 0) { finishCv.notify_one(); }
+    }
+}
+} // namespace spexplain
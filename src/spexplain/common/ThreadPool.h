@@ -0,0 +1,49 @@
+#ifndef SPEXPLAIN_THREADPOOL_H
+#define SPEXPLAIN_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spexplain {
+// Persistent threads that repeatedly run a job in parallel, which saves creating threads within hot loops
+// The calling thread also takes part in each run, with the index 0
+class ThreadPool {
+public:
+    using Job = std::function<void(std::size_t idx)>;
+
+    // The no. threads including the calling one
+    explicit ThreadPool(std::size_t size);
+    ~ThreadPool();
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool & operator=(ThreadPool const &) = delete;
+
+    std::size_t size() const { return threads.size() + 1; }
+
+    // Runs the job with each index below `n` and waits for all of them, then rethrows the first exception if any
+    void run(std::size_t n, Job const &);
+
+protected:
+    void work(std::size_t idx);
+
+    std::vector<std::jthread> threads{};
+
+    std::mutex mtx{};
+    std::condition_variable startCv{};
+    std::condition_variable finishCv{};
+
+    Job const * jobPtr{};
+    std::size_t jobSize{};
+    // Incremented with each run s.t. the threads do not run the same job twice
+    std::size_t generation{};
+    std::size_t nRunning{};
+    std::exception_ptr exceptionPtr{};
+    bool stopping{false};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_THREADPOOL_H
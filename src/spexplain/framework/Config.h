@@ -4,6 +4,7 @@
 #include "Framework.h"
 #include "explanation/IntervalExplanation.h"
 
+#include <spexplain/network/BoundPropagation.h>
 #include <spexplain/network/Dataset.h>
 
 #include <chrono>
@@ -20,12 +21,14 @@ public:
     // Not always, it may use Marabou if suitable:
     // static inline std::string const defaultVerifierName = "opensmt";
     static inline std::string const defaultExplanationsFileName = "phi.txt";
+    static inline std::string const defaultLookupFileName = "lookup.txt";
 
     void setVerifierName(std::string_view name) { verifierName = name; }
 
     void setExplanationsFileName(std::string_view fileName) { explanationsFileName = fileName; }
     void setStatsFileName(std::string_view fileName) { statsFileName = fileName; }
     void setTimesFileName(std::string_view fileName) { timesFileName = fileName; }
+    void setRecordsFileName(std::string_view fileName) { recordsFileName = fileName; }
 
     void setVerbosity(Verbosity verb) { verbosity = verb; }
     void beVerbose() { setVerbosity(1); }
@@ -60,6 +63,30 @@ public:
         timeLimitPerExplanation = std::chrono::milliseconds{limit_ms};
     }
 
+    void setThreads(std::size_t n) { threads = n; }
+    void scheduleSamplesByMargin() { _scheduleSamplesByMargin = true; }
+
+    void setBoundPropagation(Network::BoundPropagation::Type tp) { optBoundPropagationType = tp; }
+
+    void checkWithoutAssumptions() { _checkWithoutAssumptions = true; }
+
+    // Checks each competing class separately, using up to the given no. verifiers in parallel
+    void splitClassification(std::size_t nVerifiers = 1) { splitClassificationVerifiers = nVerifiers; }
+
+    // Skips the samples completed by a previous run according to its journal and appends to its outputs
+    void resume() { _resume = true; }
+
+    // Measures the time spent in the individual phases and prints it into the statistics
+    void profile() { _profile = true; }
+    // Also writes the timeline of the phases in the Chrome trace-event format
+    void setTraceFileName(std::string_view fileName) {
+        traceFileName = fileName;
+        profile();
+    }
+
+    // If not verifying, the reused explanations are trusted
+    void reuseExplanations(bool verify = true) { optVerifyReusedExplanations = verify; }
+
     [[nodiscard]]
     std::string_view getVerifierName() const { return verifierName; }
     [[nodiscard]]
@@ -80,6 +107,10 @@ public:
     std::string_view getTimesFileName() const { return timesFileName; }
     [[nodiscard]]
     bool timesFileNameIsSet() const { return not getTimesFileName().empty(); }
+    [[nodiscard]]
+    std::string_view getRecordsFileName() const { return recordsFileName; }
+    [[nodiscard]]
+    bool recordsFileNameIsSet() const { return not getRecordsFileName().empty(); }
 
     [[nodiscard]]
     Verbosity getVerbosity() const { return verbosity; }
@@ -162,12 +193,54 @@ public:
     [[nodiscard]]
     bool timeLimitPerExplanationIsSet() const { return getTimeLimitPerExplanation().count() > 0; }
 
+    [[nodiscard]]
+    std::size_t getThreads() const { return threads; }
+    [[nodiscard]]
+    bool isParallel() const { return getThreads() > 1; }
+    [[nodiscard]]
+    bool schedulingSamplesByMargin() const { return _scheduleSamplesByMargin; }
+
+    [[nodiscard]]
+    bool usingBoundPropagation() const { return optBoundPropagationType.has_value(); }
+    [[nodiscard]]
+    Network::BoundPropagation::Type const & getBoundPropagationType() const {
+        assert(usingBoundPropagation());
+        return *optBoundPropagationType;
+    }
+
+    [[nodiscard]]
+    bool checkingWithAssumptions() const { return not _checkWithoutAssumptions; }
+
+    [[nodiscard]]
+    bool splittingClassification() const { return splitClassificationVerifiers > 0; }
+    [[nodiscard]]
+    std::size_t getSplitClassificationVerifiers() const { return splitClassificationVerifiers; }
+
+    [[nodiscard]]
+    bool resuming() const { return _resume; }
+
+    [[nodiscard]]
+    bool profiling() const { return _profile; }
+    [[nodiscard]]
+    std::string_view getTraceFileName() const { return traceFileName; }
+    [[nodiscard]]
+    bool tracing() const { return not getTraceFileName().empty(); }
+
+    [[nodiscard]]
+    bool reusingExplanations() const { return optVerifyReusedExplanations.has_value(); }
+    [[nodiscard]]
+    bool verifyingReusedExplanations() const {
+        assert(reusingExplanations());
+        return *optVerifyReusedExplanations;
+    }
+
 protected:
     std::string_view verifierName{};
 
     std::string_view explanationsFileName{};
     std::string_view statsFileName{};
     std::string_view timesFileName{};
+    std::string_view recordsFileName{};
 
     Verbosity verbosity{};
 
@@ -185,6 +258,22 @@ protected:
     std::optional<Network::Classification::Label> optFilterSamplesOfExpectedClass{};
 
     std::chrono::milliseconds timeLimitPerExplanation{};
+
+    std::size_t threads{1};
+    bool _scheduleSamplesByMargin{};
+
+    std::optional<Network::BoundPropagation::Type> optBoundPropagationType{};
+
+    bool _checkWithoutAssumptions{};
+
+    std::size_t splitClassificationVerifiers{};
+
+    bool _resume{};
+
+    bool _profile{};
+    std::string_view traceFileName{};
+
+    std::optional<bool> optVerifyReusedExplanations{};
 };
 } // namespace spexplain
 
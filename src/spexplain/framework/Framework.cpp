@@ -1,9 +1,11 @@
 #include "Framework.h"
 
 #include "Config.h"
+#include "Lookup.h"
 #include "Parse.h"
 #include "Preprocess.h"
 #include "Print.h"
+#include "Serve.h"
 #include "expand/Expand.h"
 
 #include <spexplain/common/Macro.h>
@@ -84,6 +86,11 @@ void Framework::setTimesFileName(std::string_view fileName) {
     printPtr->setTimesFileName(fileName);
 }
 
+void Framework::setRecordsFileName(std::string_view fileName) {
+    assert(printPtr);
+    printPtr->setRecordsFileName(fileName);
+}
+
 void Framework::dumpDomainsAsSmtLib2Query() {
     //++ move outside of Expand -> probably also move the verifier right into the fw
     expandPtr->dumpDomainsAsSmtLib2Query();
@@ -121,4 +128,14 @@ Explanations Framework::expand(std::string_view fileName, Network::Dataset & dat
 void Framework::expand(Explanations & explanations, Network::Dataset const & data) {
     (*expandPtr)(explanations, data);
 }
+
+void Framework::serve(std::string_view socketPath) {
+    Serve serve_{*this};
+    serve_(socketPath);
+}
+
+void Framework::lookup(std::string_view explanationsFileName, Network::Dataset const & data) {
+    Lookup lookup_{*this};
+    lookup_(explanationsFileName, data);
+}
 } // namespace spexplain
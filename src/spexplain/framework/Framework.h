@@ -65,6 +65,7 @@ public:
     void setExplanationsFileName(std::string_view fileName);
     void setStatsFileName(std::string_view fileName);
     void setTimesFileName(std::string_view fileName);
+    void setRecordsFileName(std::string_view fileName);
 
     std::size_t varSize() const { return varNames.size(); }
     VarName const & getVarName(VarIdx idx) const { return varNames[idx]; }
@@ -82,11 +83,19 @@ public:
     // Allows further expansion of already existing explanations
     void expand(Explanations &, Network::Dataset const &);
 
+    // Explains samples received over a Unix domain socket until interrupted
+    void serve(std::string_view socketPath);
+
+    // Finds which explanations in a file cover the samples, builds a spatial index of the explanations
+    void lookup(std::string_view explanationsFileName, Network::Dataset const &);
+
 protected:
     friend class PartialExplanation;
 
     class Preprocess;
     class Parse;
+    class Serve;
+    class Lookup;
 
     class Print;
 
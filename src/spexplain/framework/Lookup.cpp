@@ -0,0 +1,134 @@
+#include "Lookup.h"
+
+#include "Config.h"
+#include "Parse.h"
+#include "Print.h"
+#include "expand/Expand.h"
+#include "explanation/IntervalExplanation.h"
+
+#include <spexplain/common/String.h>
+#include <spexplain/network/Dataset.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace spexplain {
+Framework::Lookup::Lookup(Framework & fw) : framework{fw}, index{fw} {}
+
+void Framework::Lookup::operator()(std::string_view explanationsFileName, Network::Dataset const & data) {
+    auto const & conf = framework.getConfig();
+    auto const & print = framework.getPrint();
+    auto & cinfo = print.info();
+    auto & cexp = print.explanations();
+
+    auto const buildStart = std::chrono::steady_clock::now();
+    loadExplanations(explanationsFileName);
+    index.build();
+    std::chrono::duration<double> const buildTime = std::chrono::steady_clock::now() - buildStart;
+
+    cinfo << "Indexed explanations: " << index.size() << " (" << buildTime.count() << "s)" << std::endl;
+
+    std::size_t const size = data.size();
+    std::size_t const nThreads = std::max(std::min(conf.getThreads(), size), std::size_t{1});
+
+    struct Result {
+        std::ostringstream os{};
+        std::size_t nCovered{};
+        std::exception_ptr exceptionPtr{};
+    };
+    std::vector<Result> results(nThreads);
+
+    auto const queryStart = std::chrono::steady_clock::now();
+
+    auto work = [&](std::size_t threadIdx) {
+        auto & res = results[threadIdx];
+        try {
+            std::size_t const begin = threadIdx * size / nThreads;
+            std::size_t const end = (threadIdx + 1) * size / nThreads;
+            res.nCovered = lookupSamples(res.os, data, begin, end);
+        } catch (...) {
+            res.exceptionPtr = std::current_exception();
+        }
+    };
+
+    if (nThreads == 1) {
+        work(0);
+    } else {
+        std::vector<std::jthread> threads;
+        threads.reserve(nThreads);
+        for (std::size_t threadIdx = 0; threadIdx < nThreads; ++threadIdx) {
+            threads.emplace_back(work, threadIdx);
+        }
+    }
+
+    std::size_t nCovered = 0;
+    for (auto & res : results) {
+        if (res.exceptionPtr) { std::rethrow_exception(res.exceptionPtr); }
+        cexp << res.os.view();
+        nCovered += res.nCovered;
+    }
+
+    std::chrono::duration<double> const queryTime = std::chrono::steady_clock::now() - queryStart;
+
+    cinfo << "Covered samples: " << nCovered << "/" << size << " (" << queryTime.count() << "s)" << std::endl;
+}
+
+void Framework::Lookup::loadExplanations(std::string_view fileName) {
+    std::ifstream ifs{std::string{fileName}};
+    if (not ifs.good()) { throw std::ifstream::failure{"Could not open explanations file: "s + std::string{fileName}}; }
+
+    Parse parse{framework};
+    auto const & network = framework.getNetwork();
+
+    std::string_view const invalidStr = Expand::invalidExplanationString;
+
+    std::string line;
+    for (std::size_t lineNum = 1; std::getline(ifs, line); ++lineNum) {
+        std::string_view const lineView = trim(line);
+        if (lineView.empty() or lineView.starts_with(invalidStr)) { continue; }
+
+        auto explanationPtr = parse.parseIntervalExplanation(lineView);
+        assert(explanationPtr);
+        auto * iexpPtr = dynamic_cast<IntervalExplanation const *>(explanationPtr.get());
+        if (not iexpPtr) { throw std::logic_error{"Expected an interval explanation:\n"s + line}; }
+
+        [[maybe_unused]] Idx const idx = index.insert(*iexpPtr);
+        assert(idx == lineNumbers.size());
+        lineNumbers.push_back(lineNum);
+
+        // Any point within the box is classified the same if the explanation is valid
+        labels.push_back(network(index.makeCenter(idx)).classification.label);
+    }
+}
+
+std::size_t Framework::Lookup::lookupSamples(std::ostream & os, Network::Dataset const & data, std::size_t begin,
+                                             std::size_t end) const {
+    std::size_t nCovered = 0;
+    std::vector<Idx> found;
+    for (std::size_t sampleIdx = begin; sampleIdx < end; ++sampleIdx) {
+        found.clear();
+        index.find(data.getSample(sampleIdx), found);
+        if (found.empty()) {
+            os << noneString << '\n';
+            continue;
+        }
+
+        ++nCovered;
+        bool first = true;
+        for (Idx idx : found) {
+            if (not first) { os << ' '; }
+            first = false;
+            os << lineNumbers[idx] << ':' << labels[idx];
+        }
+        os << '\n';
+    }
+    return nCovered;
+}
+} // namespace spexplain
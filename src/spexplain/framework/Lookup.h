@@ -0,0 +1,43 @@
+#ifndef SPEXPLAIN_LOOKUP_H
+#define SPEXPLAIN_LOOKUP_H
+
+#include "Framework.h"
+
+#include "explanation/IntervalExplanationIndex.h"
+
+#include <spexplain/network/Network.h>
+
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+namespace spexplain {
+// Finds the explanations from a file that cover the samples of a dataset, together with the labels of the explanations
+// For each sample, it prints a line '<line>:<label>[ <line>:<label>]...' with the 1-based lines of the file,
+// or 'none' if no explanation covers the sample
+class Framework::Lookup {
+public:
+    static constexpr char const * noneString = "none";
+
+    Lookup(Framework &);
+
+    void operator()(std::string_view explanationsFileName, Network::Dataset const &);
+
+protected:
+    using Idx = IntervalExplanationIndex::Idx;
+
+    void loadExplanations(std::string_view fileName);
+
+    // Returns the no. samples covered by at least one explanation
+    std::size_t lookupSamples(std::ostream &, Network::Dataset const &, std::size_t begin, std::size_t end) const;
+
+    Framework & framework;
+
+    IntervalExplanationIndex index;
+
+    std::vector<std::size_t> lineNumbers{};
+    std::vector<Network::Classification::Label> labels{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_LOOKUP_H
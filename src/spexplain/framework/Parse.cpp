@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <cctype>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -26,6 +27,13 @@ Explanations Framework::Parse::parseIntervalExplanations(std::string_view fileNa
     return parseIntervalExplanationsSmtLib2(ifs, data);
 }
 
+std::unique_ptr<Explanation> Framework::Parse::parseIntervalExplanation(std::string_view str) const {
+    std::istringstream iss{std::string{str}};
+    if (auto explanationPtr = parseIntervalExplanationSmtLib2(iss)) { return explanationPtr; }
+
+    throw std::logic_error{"Invalid interval explanation:\n"s + std::string{str}};
+}
+
 Explanations Framework::Parse::parseIntervalExplanationsSmtLib2(std::istream & is, Network::Dataset const & data) const {
     std::size_t const maxSize = data.size();
     Explanations explanations;
@@ -47,33 +55,34 @@ Explanations Framework::Parse::parseIntervalExplanationsSmtLib2(std::istream & i
 }
 
 namespace {
-    //+ only assertions
+    // On error, the stream is left failed
     long parseInt(std::istream & is) {
-        assert(is);
-        long num;
+        long num{};
         is >> num;
-        assert(is);
         return num;
     }
 
     Float parseFloat(std::istream & is) {
         char c;
 
-        assert(is);
         is >> c;
-        assert(is);
+        if (not is) { return {}; }
         if (std::isdigit(c) or c == '-') {
             is.putback(c);
             return parseInt(is);
         }
 
-        assert(c == '(');
-        is >> c;
-        assert(is and c == '/');
+        if (c != '(' or not (is >> c) or c != '/') {
+            is.setstate(std::ios::failbit);
+            return {};
+        }
         auto num = parseInt(is);
         auto den = parseInt(is);
         is >> c;
-        assert(is and c == ')');
+        if (not is or c != ')') {
+            is.setstate(std::ios::failbit);
+            return {};
+        }
         return static_cast<double>(num) / den;
     }
 
@@ -95,6 +104,7 @@ namespace {
         if (not is or str[0] != 'x') { return {invalidVarIdx, {}}; }
         VarIdx varIdx = getVarIdx(str);
         Float val = parseFloat(is);
+        if (not is) { return {invalidVarIdx, {}}; }
         is >> c;
         if (not is or c != ')') { return {invalidVarIdx, {}}; }
         return {varIdx, Bound{type, val}};
@@ -115,7 +125,17 @@ std::unique_ptr<Explanation> Framework::Parse::parseIntervalExplanationSmtLib2(s
         if (not is) { return nullptr; }
         if (str != "and") {
             auto [varIdx, bnd] = parseBound(is, str);
-            if (varIdx == invalidVarIdx) { return nullptr; }
+            if (not isValidBound(varIdx, bnd)) { return nullptr; }
+            if (iexplanation.contains(varIdx)) {
+                // Only a single lower and a single upper bound that do not cross
+                if (bnd.isEq() or iexplanation.isPoint(varIdx)) { return nullptr; }
+                Float const val = bnd.getValue();
+                if (bnd.isLower()) {
+                    if (iexplanation.hasLowerBound(varIdx) or val > iexplanation.getUpper(varIdx)) { return nullptr; }
+                } else if (iexplanation.hasUpperBound(varIdx) or val < iexplanation.getLower(varIdx)) {
+                    return nullptr;
+                }
+            }
             iexplanation.insertBound(varIdx, std::move(bnd));
             continue;
         }
@@ -126,8 +146,10 @@ std::unique_ptr<Explanation> Framework::Parse::parseIntervalExplanationSmtLib2(s
         is >> c >> str;
         if (not is or c != '(') { return nullptr; }
         auto [varIdx2, hi] = parseBound(is, str);
-        if (varIdx1 == invalidVarIdx or varIdx1 != varIdx2) { return nullptr; }
-        if (not lo.isLower() or not hi.isUpper()) { return nullptr; }
+        if (varIdx1 != varIdx2) { return nullptr; }
+        if (not isValidBound(varIdx1, lo) or not isValidBound(varIdx2, hi)) { return nullptr; }
+        if (not lo.isLower() or not hi.isUpper() or lo.getValue() > hi.getValue()) { return nullptr; }
+        if (iexplanation.contains(varIdx1)) { return nullptr; }
         is >> c;
         if (not is or c != ')') { return nullptr; }
         iexplanation.insertVarBound(VarBound{framework, varIdx1, std::move(lo), std::move(hi)});
@@ -135,4 +157,18 @@ std::unique_ptr<Explanation> Framework::Parse::parseIntervalExplanationSmtLib2(s
 
     return MAKE_UNIQUE(std::move(iexplanation));
 }
+
+bool Framework::Parse::isValidBound(VarIdx idx, Bound const & bnd) const {
+    if (idx >= framework.varSize()) { return false; }
+
+    Float const val = bnd.getValue();
+    if (not std::isfinite(val)) { return false; }
+
+    auto const [dLo, dHi] = framework.getDomainInterval(idx).getBounds();
+    if (val < dLo or val > dHi) { return false; }
+    // Bounds that correspond to the bounds of the domain are not expected
+    if (bnd.isLower() and val == dLo) { return false; }
+    if (bnd.isUpper() and val == dHi) { return false; }
+    return true;
+}
 } // namespace spexplain
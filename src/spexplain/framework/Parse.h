@@ -3,6 +3,7 @@
 
 #include "Framework.h"
 
+#include <spexplain/common/Bound.h>
 #include <spexplain/network/Network.h>
 
 namespace spexplain {
@@ -11,11 +12,16 @@ public:
     Parse(Framework &);
 
     Explanations parseIntervalExplanations(std::string_view fileName, Network::Dataset const &) const;
+    // A single explanation in the SMT-LIB2 format, e.g. received at runtime
+    std::unique_ptr<Explanation> parseIntervalExplanation(std::string_view) const;
 
 protected:
     Explanations parseIntervalExplanationsSmtLib2(std::istream &, Network::Dataset const &) const;
     std::unique_ptr<Explanation> parseIntervalExplanationSmtLib2(std::istream &) const;
 
+    // Within the domain of the variable and not trivially true
+    bool isValidBound(VarIdx, Bound const &) const;
+
     Framework & framework;
 };
 } // namespace spexplain
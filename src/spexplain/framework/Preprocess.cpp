@@ -1,8 +1,8 @@
 #include "Preprocess.h"
 
 #include "explanation/IntervalExplanation.h"
-#include "explanation/VarBound.h"
 
+#include <spexplain/common/Interval.h>
 #include <spexplain/common/Macro.h>
 #include <spexplain/network/Dataset.h>
 
@@ -18,30 +18,22 @@ void Framework::Preprocess::operator()(Network::Dataset & dataset) const {
 
     auto const & network = framework.getNetwork();
 
-    auto const & samples = dataset.getSamples();
     std::size_t const size = dataset.size();
-    assert(size == samples.size());
-    assert(not samples.empty());
-    Network::Dataset::Outputs outputs;
-    outputs.reserve(size);
-    for (auto const & sample : samples) {
-        assert(sample.size() == framework.varSize());
-        Network::Output output = network(sample);
-        outputs.push_back(std::move(output));
-    }
+    assert(size > 0);
+    assert(dataset.nInputs() == framework.varSize());
+    // Evaluated in batches
+    Network::Dataset::Outputs outputs = network.computeOutputs(dataset.getSamplesValues());
 
     assert(outputs.size() == size);
     dataset.setComputedOutputs(std::move(outputs));
 }
 
 Explanations Framework::Preprocess::makeExplanationsFromSamples(Network::Dataset const & dataset) const {
-    auto const & samples = dataset.getSamples();
     std::size_t const size = dataset.size();
-    assert(size == samples.size());
     Explanations explanations;
     explanations.reserve(size);
-    for (auto const & sample : samples) {
-        auto explanationPtr = makeExplanationFromSample(sample);
+    for (Network::Sample::Idx idx = 0; idx < size; ++idx) {
+        auto explanationPtr = makeExplanationFromSample(dataset.getSample(idx));
         explanations.push_back(std::move(explanationPtr));
     }
 
@@ -49,7 +41,7 @@ Explanations Framework::Preprocess::makeExplanationsFromSamples(Network::Dataset
     return explanations;
 }
 
-std::unique_ptr<Explanation> Framework::Preprocess::makeExplanationFromSample(Network::Sample const & sample) const {
+std::unique_ptr<Explanation> Framework::Preprocess::makeExplanationFromSample(Network::SampleView sample) const {
     std::size_t const vSize = framework.varSize();
 
     assert(sample.size() == vSize);
@@ -57,7 +49,7 @@ std::unique_ptr<Explanation> Framework::Preprocess::makeExplanationFromSample(Ne
     IntervalExplanation iexplanation{framework};
     for (VarIdx idx = 0; idx < vSize; ++idx) {
         Float val = sample[idx];
-        iexplanation.insertVarBound(VarBound{framework, idx, val});
+        iexplanation.setInterval(idx, Interval{val});
     }
 
     return MAKE_UNIQUE(std::move(iexplanation));
@@ -22,6 +22,16 @@ Framework::Print::Print(Framework const & fw) : framework{fw} {
         assert(not conf.getTimesFileName().empty());
         setTimesFileName(conf.getTimesFileName());
     }
+    if (ignoringRecords() and conf.recordsFileNameIsSet()) {
+        assert(not conf.getRecordsFileName().empty());
+        setRecordsFileName(conf.getRecordsFileName());
+    }
+}
+
+std::ios_base::openmode Framework::Print::fileOpenMode() const {
+    auto const & conf = framework.getConfig();
+    if (conf.resuming()) { return std::ios_base::out | std::ios_base::app; }
+    return std::ios_base::out | std::ios_base::trunc;
 }
 
 void Framework::Print::setExplanationsFileName(std::string_view fileName) {
@@ -30,7 +40,7 @@ void Framework::Print::setExplanationsFileName(std::string_view fileName) {
 }
 
 void Framework::Print::setExplanationsFile(std::string_view fileName) {
-    explanationsFileOs = std::ofstream{std::string{fileName}};
+    explanationsFileOs = std::ofstream{std::string{fileName}, fileOpenMode()};
     explanationsOsPtr = &explanationsFileOs;
 }
 
@@ -40,7 +50,7 @@ void Framework::Print::setStatsFileName(std::string_view fileName) {
 }
 
 void Framework::Print::setStatsFile(std::string_view fileName) {
-    statsFileOs = std::ofstream{std::string{fileName}};
+    statsFileOs = std::ofstream{std::string{fileName}, fileOpenMode()};
     statsOsPtr = &statsFileOs;
 }
 
@@ -50,7 +60,17 @@ void Framework::Print::setTimesFileName(std::string_view fileName) {
 }
 
 void Framework::Print::setTimesFile(std::string_view fileName) {
-    timesFileOs = std::ofstream{std::string{fileName}};
+    timesFileOs = std::ofstream{std::string{fileName}, fileOpenMode()};
     timesOsPtr = &timesFileOs;
 }
+
+void Framework::Print::setRecordsFileName(std::string_view fileName) {
+    recordsFileName = fileName;
+    setRecordsFile(fileName);
+}
+
+void Framework::Print::setRecordsFile(std::string_view fileName) {
+    recordsFileOs = std::ofstream{std::string{fileName}, fileOpenMode()};
+    recordsOsPtr = &recordsFileOs;
+}
 } // namespace spexplain
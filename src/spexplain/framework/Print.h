@@ -17,11 +17,18 @@ public:
     void setExplanationsFileName(std::string_view fileName);
     void setStatsFileName(std::string_view fileName);
     void setTimesFileName(std::string_view fileName);
+    void setRecordsFileName(std::string_view fileName);
+
+    std::string_view getExplanationsFileName() const { return explanationsFileName; }
+    std::string_view getStatsFileName() const { return statsFileName; }
+    std::string_view getTimesFileName() const { return timesFileName; }
+    std::string_view getRecordsFileName() const { return recordsFileName; }
 
     bool ignoringInfo() const { return ignoring(infoOsPtr); }
     bool ignoringExplanations() const { return ignoring(explanationsOsPtr); }
     bool ignoringStats() const { return ignoring(statsOsPtr); }
     bool ignoringTimes() const { return ignoring(timesOsPtr); }
+    bool ignoringRecords() const { return ignoring(recordsOsPtr); }
 
     std::ostream & info() const {
         assert(infoOsPtr);
@@ -39,6 +46,11 @@ public:
         assert(timesOsPtr);
         return *timesOsPtr;
     }
+    // One JSON object per line for each sample
+    std::ostream & records() const {
+        assert(recordsOsPtr);
+        return *recordsOsPtr;
+    }
 
 protected:
     Print(Print const &) = delete;
@@ -51,6 +63,10 @@ protected:
     void setExplanationsFile(std::string_view fileName);
     void setStatsFile(std::string_view fileName);
     void setTimesFile(std::string_view fileName);
+    void setRecordsFile(std::string_view fileName);
+
+    // When resuming, the output files are appended to
+    std::ios_base::openmode fileOpenMode() const;
 
     bool ignoring(std::ostream * osPtr) const {
         assert(osPtr);
@@ -65,13 +81,16 @@ protected:
     std::ostream * explanationsOsPtr{&absorb};
     std::ostream * statsOsPtr{&absorb};
     std::ostream * timesOsPtr{&absorb};
+    std::ostream * recordsOsPtr{&absorb};
 
     std::string explanationsFileName{};
     std::string statsFileName{};
     std::string timesFileName{};
+    std::string recordsFileName{};
     std::ofstream explanationsFileOs{};
     std::ofstream statsFileOs{};
     std::ofstream timesFileOs{};
+    std::ofstream recordsFileOs{};
 };
 } // namespace spexplain
 
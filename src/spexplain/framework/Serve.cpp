@@ -0,0 +1,452 @@
+#include "Serve.h"
+
+#include "Config.h"
+#include "Parse.h"
+#include "Preprocess.h"
+#include "Print.h"
+#include "expand/Expand.h"
+#include "explanation/Explanation.h"
+#include "explanation/IntervalExplanation.h"
+
+// for the destructor of the workers
+#include "expand/strategy/Strategy.h"
+
+#include <verifiers/Verifier.h>
+
+#include <spexplain/common/String.h>
+#include <spexplain/network/Dataset.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace spexplain {
+namespace {
+    // How often the listening thread checks whether to stop
+    constexpr int pollTimeoutMs = 100;
+
+    constexpr std::size_t recvBufferSize = 4096;
+
+    // A client that exceeds this without sending a whole line is dropped
+    constexpr std::size_t maxLineSize = std::size_t{1} << 24;
+    // A client is not read from until its pending requests get below this
+    constexpr std::size_t maxPendingRequests = 64;
+
+    volatile std::sig_atomic_t interrupted = 0;
+
+    void interrupt(int) { interrupted = 1; }
+
+    bool isBlank(char c) { return c == ' ' or c == '\t' or c == '\r'; }
+} // namespace
+
+class Framework::Serve::Connection {
+public:
+    explicit Connection(int fd_) : fd{fd_} { assert(fd >= 0); }
+    ~Connection() { ::close(fd); }
+    Connection(Connection const &) = delete;
+    Connection & operator=(Connection const &) = delete;
+
+    int getFd() const { return fd; }
+
+    // Receives the available data once and appends the complete non-empty lines
+    // Returns false if the client disconnected or exceeded the line size limit
+    bool receive(std::vector<std::string> & lines);
+
+    void write(std::string_view);
+
+    // The following are guarded by the mutex of Serve
+    std::deque<std::string> pendingRequests{};
+    // Whether it is within `readyConnections` or being served by a worker
+    bool scheduled{false};
+    // The client is dropped, e.g. after a failed write
+    bool closed{false};
+
+protected:
+    int fd;
+
+    // Only accessed by the listening thread
+    std::string buffer{};
+};
+
+bool Framework::Serve::Connection::receive(std::vector<std::string> & lines) {
+    char buf[recvBufferSize];
+    ::ssize_t n;
+    do {
+        n = ::recv(fd, buf, sizeof(buf), 0);
+    } while (n < 0 and errno == EINTR);
+    if (n < 0) { throw std::system_error{errno, std::generic_category(), "Receiving from a client failed"}; }
+    if (n == 0) { return false; }
+    buffer.append(buf, n);
+
+    std::size_t lineBegin = 0;
+    for (std::size_t pos; (pos = buffer.find('\n', lineBegin)) != std::string::npos; lineBegin = pos + 1) {
+        std::string_view const line = trim(std::string_view{buffer}.substr(lineBegin, pos - lineBegin));
+        if (not line.empty()) { lines.emplace_back(line); }
+    }
+    buffer.erase(0, lineBegin);
+
+    if (buffer.size() <= maxLineSize) { return true; }
+    buffer = {};
+    return false;
+}
+
+void Framework::Serve::Connection::write(std::string_view str) {
+    while (not str.empty()) {
+        ::ssize_t const n = ::send(fd, str.data(), str.size(), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            throw std::system_error{errno, std::generic_category(), "Sending to a client failed"};
+        }
+        str.remove_prefix(n);
+    }
+}
+
+Framework::Serve::Serve(Framework & fw) : framework{fw} {}
+
+void Framework::Serve::operator()(std::string_view socketPath) {
+    auto const & config = framework.getConfig();
+    auto & print = framework.getPrint();
+    auto & cinfo = print.info();
+
+    struct ::sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument{"Socket path is too long: "s + std::string{socketPath}};
+    }
+    std::ranges::copy(socketPath, addr.sun_path);
+    std::string const socketPathStr{socketPath};
+
+    // A socket left behind by a previous run would make the bind fail
+    struct ::stat st{};
+    if (::stat(socketPathStr.c_str(), &st) == 0 and S_ISSOCK(st.st_mode)) { ::unlink(socketPathStr.c_str()); }
+
+    int const listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) { throw std::system_error{errno, std::generic_category(), "Could not create a socket"}; }
+    if (::bind(listenFd, reinterpret_cast<struct ::sockaddr const *>(&addr), sizeof(addr)) != 0 or
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        int const err = errno;
+        ::close(listenFd);
+        throw std::system_error{err, std::generic_category(), "Could not listen on socket " + socketPathStr};
+    }
+
+    // Without SA_RESTART s.t. the blocking calls get interrupted
+    struct ::sigaction sa{};
+    sa.sa_handler = interrupt;
+    sigemptyset(&sa.sa_mask);
+    struct ::sigaction oldSaInt{};
+    struct ::sigaction oldSaTerm{};
+    ::sigaction(SIGINT, &sa, &oldSaInt);
+    ::sigaction(SIGTERM, &sa, &oldSaTerm);
+    interrupted = 0;
+
+    std::size_t const nWorkers = config.getThreads();
+    cinfo << "Listening on: " << socketPath << " (workers: " << nWorkers << ")" << std::endl;
+
+    std::vector<ConnectionPtr> connections;
+    std::exception_ptr exceptionPtr{};
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(nWorkers);
+        for (std::size_t workerIdx = 0; workerIdx < nWorkers; ++workerIdx) {
+            threads.emplace_back([this, &exceptionPtr] {
+                try {
+                    work();
+                } catch (...) {
+                    std::lock_guard lock{mtx};
+                    if (not exceptionPtr) { exceptionPtr = std::current_exception(); }
+                    stopping = true;
+                    requestsCv.notify_all();
+                }
+            });
+        }
+
+        try {
+            while (not interrupted and not stopping) {
+                pollClients(listenFd, connections);
+            }
+        } catch (...) {
+            std::lock_guard lock{mtx};
+            if (not exceptionPtr) { exceptionPtr = std::current_exception(); }
+        }
+
+        {
+            std::lock_guard lock{mtx};
+            stopping = true;
+            requestsCv.notify_all();
+        }
+    }
+
+    readyConnections.clear();
+    connections.clear();
+
+    ::close(listenFd);
+    ::unlink(socketPathStr.c_str());
+
+    ::sigaction(SIGINT, &oldSaInt, nullptr);
+    ::sigaction(SIGTERM, &oldSaTerm, nullptr);
+
+    if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+
+    cinfo << "\nDone." << std::endl;
+}
+
+void Framework::Serve::pollClients(int listenFd, std::vector<ConnectionPtr> & connections) {
+    std::vector<struct ::pollfd> pfds;
+    pfds.reserve(connections.size() + 1);
+    {
+        std::lock_guard lock{mtx};
+        std::erase_if(connections, [](auto const & connectionPtr) { return connectionPtr->closed; });
+        for (auto const & connectionPtr : connections) {
+            // The client is not read from until the workers catch up with it
+            short const events = (connectionPtr->pendingRequests.size() < maxPendingRequests) ? POLLIN : 0;
+            pfds.push_back({.fd = connectionPtr->getFd(), .events = events, .revents = 0});
+        }
+    }
+    pfds.push_back({.fd = listenFd, .events = POLLIN, .revents = 0});
+
+    int const ret = ::poll(pfds.data(), pfds.size(), pollTimeoutMs);
+    if (ret < 0) {
+        if (errno == EINTR) { return; }
+        throw std::system_error{errno, std::generic_category(), "Polling the clients failed"};
+    }
+    if (ret == 0) { return; }
+
+    std::vector<ConnectionPtr> receivingConnections;
+    receivingConnections.reserve(connections.size() + 1);
+    std::size_t const nConnections = connections.size();
+    for (std::size_t i = 0; i < nConnections; ++i) {
+        auto & connectionPtr = connections[i];
+        if (pfds[i].revents == 0) {
+            receivingConnections.push_back(std::move(connectionPtr));
+            continue;
+        }
+
+        std::vector<std::string> lines;
+        bool receiving;
+        try {
+            receiving = connectionPtr->receive(lines);
+        } catch (std::system_error const &) {
+            receiving = false;
+        }
+        queueRequests(connectionPtr, std::move(lines));
+        // Otherwise the requests received before the client disconnected are still served
+        if (receiving) { receivingConnections.push_back(std::move(connectionPtr)); }
+    }
+    connections = std::move(receivingConnections);
+
+    if (pfds.back().revents == 0) { return; }
+
+    int const fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) {
+        if (errno == EINTR or errno == ECONNABORTED) { return; }
+        throw std::system_error{errno, std::generic_category(), "Accepting a client failed"};
+    }
+    connections.push_back(std::make_shared<Connection>(fd));
+}
+
+void Framework::Serve::queueRequests(ConnectionPtr const & connectionPtr, std::vector<std::string> && lines) {
+    if (lines.empty()) { return; }
+
+    std::lock_guard lock{mtx};
+    auto & connection = *connectionPtr;
+    if (connection.closed) { return; }
+
+    std::ranges::move(lines, std::back_inserter(connection.pendingRequests));
+    if (connection.scheduled) { return; }
+
+    connection.scheduled = true;
+    readyConnections.push_back(connectionPtr);
+    requestsCv.notify_one();
+}
+
+std::optional<Framework::Serve::Request> Framework::Serve::nextRequest() {
+    std::unique_lock lock{mtx};
+    requestsCv.wait(lock, [this] { return stopping or not readyConnections.empty(); });
+    if (stopping) { return std::nullopt; }
+
+    ConnectionPtr connectionPtr = std::move(readyConnections.front());
+    readyConnections.pop_front();
+    auto & pendingRequests = connectionPtr->pendingRequests;
+    assert(connectionPtr->scheduled);
+    assert(not pendingRequests.empty());
+
+    std::string line = std::move(pendingRequests.front());
+    pendingRequests.pop_front();
+    return Request{.connectionPtr = std::move(connectionPtr), .line = std::move(line)};
+}
+
+void Framework::Serve::finishRequest(ConnectionPtr const & connectionPtr) {
+    std::lock_guard lock{mtx};
+    auto & connection = *connectionPtr;
+    assert(connection.scheduled);
+    if (connection.closed or connection.pendingRequests.empty()) {
+        connection.scheduled = false;
+        return;
+    }
+
+    // Behind the other clients, s.t. a single client cannot occupy the workers
+    readyConnections.push_back(connectionPtr);
+    requestsCv.notify_one();
+}
+
+std::unique_ptr<Framework::Expand> Framework::Serve::makeWorker() const {
+    auto workerPtr = framework.getExpand().makeWorker();
+    workerPtr->initVerifier();
+    return workerPtr;
+}
+
+void Framework::Serve::work() {
+    // The verifier is initialized only once and then reused across the requests
+    auto workerPtr = makeWorker();
+
+    while (auto optRequest = nextRequest()) {
+        auto const & [connectionPtr, line] = *optRequest;
+        std::string const response = serveRequest(workerPtr, line);
+        try {
+            connectionPtr->write(response);
+        } catch (std::system_error const &) {
+            // The client is just dropped
+            std::lock_guard lock{mtx};
+            connectionPtr->closed = true;
+            connectionPtr->pendingRequests.clear();
+        }
+        finishRequest(connectionPtr);
+    }
+}
+
+std::string Framework::Serve::serveRequest(std::unique_ptr<Expand> & workerPtr, std::string_view request) {
+    std::string response;
+    try {
+        response = processRequest(workerPtr, request);
+    } catch (std::exception const & e) {
+        response = errorResponsePrefix + std::string{e.what()};
+        std::ranges::replace(response, '\n', ' ');
+        response += '\n';
+    }
+
+    assert(not response.empty() and response.back() == '\n');
+    if (not response.ends_with("\n\n")) { response += '\n'; }
+    return response;
+}
+
+std::string Framework::Serve::processRequest(std::unique_ptr<Expand> & workerPtr, std::string_view request) {
+    auto & network = framework.getNetwork();
+    auto & print = framework.getPrint();
+    bool const printingStats = not print.ignoringStats();
+    bool const printingTimes = not print.ignoringTimes();
+    bool const printingRecords = not print.ignoringRecords();
+
+    auto const delimPos = request.find(';');
+    std::string_view const valuesStr = request.substr(0, delimPos);
+    std::string_view const explanationStr =
+        (delimPos == std::string_view::npos) ? std::string_view{} : trim(request.substr(delimPos + 1));
+
+    Network::Values values = parseSampleValues(valuesStr);
+    // The expected class is not known, it is assumed to be the computed one
+    Network::Output output = network(Network::SampleView{values});
+    Network::Classification const cls = output.classification;
+    Network::Dataset data{network, std::move(values), {cls}};
+    data.setComputedOutputs({std::move(output)});
+
+    Explanations explanations;
+    if (explanationStr.empty()) {
+        explanations.push_back(framework.getPreprocess().makeExplanationFromSample(data.getSample(0)));
+    } else {
+        Parse parse{framework};
+        auto explanationPtr = parse.parseIntervalExplanation(explanationStr);
+        assert(dynamic_cast<IntervalExplanation const *>(explanationPtr.get()));
+        auto const & iexplanation = static_cast<IntervalExplanation const &>(*explanationPtr);
+        auto const sample = data.getSample(0);
+        std::size_t const esize = iexplanation.size();
+        for (VarIdx idx = 0; idx < esize; ++idx) {
+            if (not iexplanation.contains(idx)) { continue; }
+            if (iexplanation.getInterval(idx).contains(sample[idx])) { continue; }
+            throw std::logic_error{"The explanation does not contain the sample at "s + framework.getVarName(idx)};
+        }
+        explanations.push_back(std::move(explanationPtr));
+    }
+
+    std::ostringstream explanationOs;
+    std::ostringstream statsOs;
+    std::ostringstream timesOs;
+    std::ostringstream recordsOs;
+    try {
+        workerPtr->explainSample(explanations, data, 0, explanationOs, statsOs, timesOs, recordsOs);
+    } catch (std::exception const &) {
+        // The verifier may be left with the model and the classification asserted
+        workerPtr = makeWorker();
+        throw;
+    }
+
+    std::string response = std::move(explanationOs).str();
+
+    std::lock_guard lock{mtx};
+    print.explanations() << response;
+    if (printingStats) { print.stats() << statsOs.view(); }
+    if (printingTimes) { print.times() << timesOs.view(); }
+    if (printingRecords) { print.records() << recordsOs.view(); }
+
+    return response;
+}
+
+Network::Values Framework::Serve::parseSampleValues(std::string_view str) const {
+    std::size_t const nVars = framework.varSize();
+
+    Network::Values values;
+    values.reserve(nVars);
+
+    char const * it = str.data();
+    char const * const end = str.data() + str.size();
+    while (true) {
+        while (it != end and isBlank(*it)) {
+            ++it;
+        }
+
+        Float val;
+        auto const [ptr, ec] = std::from_chars(it, end, val);
+        if (ec != std::errc{}) {
+            throw std::logic_error{"Invalid sample value: '"s + std::string{it, std::find(it, end, ',')} + "'"};
+        }
+        values.push_back(val);
+
+        it = ptr;
+        while (it != end and isBlank(*it)) {
+            ++it;
+        }
+        if (it == end) { break; }
+        if (*it != ',') { throw std::logic_error{"Unexpected character in sample: '"s + *it + "'"}; }
+        ++it;
+    }
+
+    if (values.size() != nVars) {
+        throw std::logic_error{"Unexpected no. sample values: " + std::to_string(values.size()) +
+                               ", expected: " + std::to_string(nVars)};
+    }
+
+    for (VarIdx idx = 0; idx < nVars; ++idx) {
+        Float const val = values[idx];
+        if (std::isfinite(val) and framework.getDomainInterval(idx).contains(val)) { continue; }
+        throw std::logic_error{"Sample value out of the domain of "s + framework.getVarName(idx) + ": " +
+                               std::to_string(val)};
+    }
+
+    return values;
+}
+} // namespace spexplain
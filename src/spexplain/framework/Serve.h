@@ -0,0 +1,75 @@
+#ifndef SPEXPLAIN_SERVE_H
+#define SPEXPLAIN_SERVE_H
+
+#include "Framework.h"
+
+#include <spexplain/network/Network.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace spexplain {
+// Explains samples received from clients over a Unix domain socket
+// Each request is a line '<value>[,<value>]...[;<smtlib2 explanation>]', where the optional explanation
+// is the starting point; each response is the explanation in the configured format followed by an empty line
+class Framework::Serve {
+public:
+    static constexpr char const * errorResponsePrefix = "error: ";
+
+    Serve(Framework &);
+
+    // Blocks until interrupted by SIGINT or SIGTERM
+    void operator()(std::string_view socketPath);
+
+protected:
+    class Connection;
+
+    using ConnectionPtr = std::shared_ptr<Connection>;
+
+    struct Request {
+        ConnectionPtr connectionPtr;
+        std::string line;
+    };
+
+    // The connections are read by the listening thread, which queues the individual requests
+    // The requests are handled by a pool of workers with their own verifiers that stay initialized
+    void work();
+
+    // With the verifier already initialized
+    std::unique_ptr<Expand> makeWorker() const;
+
+    // Accepts new clients and queues the requests received from the others
+    // The disconnected clients are removed from the vector
+    void pollClients(int listenFd, std::vector<ConnectionPtr> &);
+    void queueRequests(ConnectionPtr const &, std::vector<std::string> && lines);
+    std::optional<Request> nextRequest();
+    // Requeues the connection if it has more pending requests
+    void finishRequest(ConnectionPtr const &);
+
+    // Any failure is turned into an error response
+    std::string serveRequest(std::unique_ptr<Expand> & workerPtr, std::string_view request);
+
+    // Any invalid input is rejected before it reaches the worker, which is recreated if it fails anyway
+    std::string processRequest(std::unique_ptr<Expand> & workerPtr, std::string_view request);
+
+    Network::Values parseSampleValues(std::string_view) const;
+
+    Framework & framework;
+
+    std::mutex mtx{};
+    std::condition_variable requestsCv{};
+    // Each connection with pending requests is queued at most once, s.t. its requests are answered in order
+    std::deque<ConnectionPtr> readyConnections{};
+
+    std::atomic<bool> stopping{false};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_SERVE_H
@@ -0,0 +1,134 @@
+#include "Cache.h"
+
+#include "../explanation/IntervalExplanation.h"
+
+#include <cassert>
+#include <iomanip>
+#include <ostream>
+
+namespace spexplain {
+Framework::Expand::Cache::Cache(Framework const & fw) : framework{fw} {
+    std::size_t const nClasses = fw.getNetwork().nClasses();
+    buckets.reserve(nClasses);
+    for (std::size_t i = 0; i < nClasses; ++i) {
+        buckets.emplace_back(fw);
+    }
+}
+
+std::optional<Framework::Expand::Cache::Entry> Framework::Expand::Cache::find(Network::Classification::Label label,
+                                                                              Network::SampleView sample) {
+    assert(label < buckets.size());
+    assert(sample.size() == framework.varSize());
+
+    {
+        std::lock_guard lock{statsMtx};
+        ++stats.lookups;
+    }
+
+    std::shared_lock lock{bucketsMtx};
+    auto const & bucket = buckets[label];
+    auto const & entries = bucket.entries;
+
+    // The indexed entries precede the rest, hence the first match of the index is the first entry at all
+    if (bucket.indexedSize > 0) {
+        std::vector<IntervalExplanationIndex::Idx> found;
+        bucket.index.find(sample, found);
+        if (not found.empty()) {
+            assert(found.front() < bucket.indexedSize);
+            return entries[found.front()];
+        }
+    }
+
+    std::size_t const esize = entries.size();
+    for (std::size_t i = bucket.indexedSize; i < esize; ++i) {
+        auto const & entry = entries[i];
+        if (contains(entry, sample)) { return entry; }
+    }
+
+    return std::nullopt;
+}
+
+bool Framework::Expand::Cache::contains(Entry const & entry, Network::SampleView sample) {
+    std::size_t const esize = entry.vars.size();
+    for (std::size_t i = 0; i < esize; ++i) {
+        Float const val = sample[entry.vars[i]];
+        if (val < entry.lowers[i] or val > entry.uppers[i]) { return false; }
+    }
+
+    return true;
+}
+
+void Framework::Expand::Cache::insert(Network::Classification::Label label, Explanation const & explanation,
+                                      Duration duration) {
+    assert(label < buckets.size());
+
+    auto * iexpPtr = dynamic_cast<IntervalExplanation const *>(&explanation);
+    if (not iexpPtr) { return; }
+    auto const & iexplanation = *iexpPtr;
+
+    Entry entry{.vars = {}, .lowers = {}, .uppers = {}, .duration = duration};
+    std::size_t const varSize = iexplanation.varSize();
+    entry.vars.reserve(varSize);
+    entry.lowers.reserve(varSize);
+    entry.uppers.reserve(varSize);
+    std::size_t const esize = iexplanation.size();
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (not iexplanation.contains(idx)) { continue; }
+        entry.vars.push_back(idx);
+        entry.lowers.push_back(iexplanation.getLower(idx));
+        entry.uppers.push_back(iexplanation.getUpper(idx));
+    }
+
+    std::lock_guard lock{bucketsMtx};
+    auto & bucket = buckets[label];
+    [[maybe_unused]]
+    auto const boxIdx = bucket.index.insert(iexplanation);
+    assert(boxIdx == bucket.entries.size());
+    bucket.entries.push_back(std::move(entry));
+
+    if (bucket.entries.size() - bucket.indexedSize < maxUnindexedSize) { return; }
+
+    bucket.index.build();
+    bucket.indexedSize = bucket.entries.size();
+}
+
+std::unique_ptr<IntervalExplanation> Framework::Expand::Cache::makeExplanation(Entry const & entry) const {
+    auto iexplanationPtr = std::make_unique<IntervalExplanation>(framework);
+    std::size_t const esize = entry.vars.size();
+    for (std::size_t i = 0; i < esize; ++i) {
+        iexplanationPtr->setInterval(entry.vars[i], Interval{entry.lowers[i], entry.uppers[i]});
+    }
+
+    return iexplanationPtr;
+}
+
+void Framework::Expand::Cache::addHit(Duration savedTime) {
+    std::lock_guard lock{statsMtx};
+    ++stats.hits;
+    stats.savedTime += savedTime;
+}
+
+void Framework::Expand::Cache::addRejected() {
+    std::lock_guard lock{statsMtx};
+    ++stats.rejected;
+}
+
+Framework::Expand::Cache::Stats Framework::Expand::Cache::getStats() const {
+    std::lock_guard lock{statsMtx};
+    return stats;
+}
+
+void Framework::Expand::Cache::printStats(std::ostream & os) const {
+    auto const [lookups, hits, rejected, savedTime] = getStats();
+    auto const defaultPrecision = os.precision();
+
+    os << "Reused explanations: " << hits << '/' << lookups;
+    if (lookups > 0) {
+        os << " (" << std::fixed << std::setprecision(1) << (100. * hits / lookups) << "%)" << std::defaultfloat;
+    }
+    os << '\n';
+    if (rejected > 0) { os << "Rejected cached explanations: " << rejected << '\n'; }
+    os << "Saved time [s]: " << std::setprecision(3) << savedTime.count() << std::setprecision(defaultPrecision)
+       << std::endl;
+}
+} // namespace spexplain
@@ -0,0 +1,87 @@
+#ifndef SPEXPLAIN_EXPAND_CACHE_H
+#define SPEXPLAIN_EXPAND_CACHE_H
+
+#include "Expand.h"
+
+#include "../explanation/IntervalExplanationIndex.h"
+
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace spexplain {
+class IntervalExplanation;
+
+// Finished interval explanations of the samples per computed class, shared by all workers
+// Any sample of the same class that lies within the box of such explanation is explained by it as well
+class Framework::Expand::Cache {
+public:
+    using Duration = std::chrono::duration<double>;
+
+    struct Entry {
+        // Only the bounded variables, in ascending order
+        std::vector<VarIdx> vars;
+        std::vector<Float> lowers;
+        std::vector<Float> uppers;
+        // Time it took to compute the explanation
+        Duration duration;
+    };
+
+    struct Stats {
+        std::size_t lookups{};
+        std::size_t hits{};
+        // Hits that failed to be re-verified
+        std::size_t rejected{};
+        Duration savedTime{};
+    };
+
+    Cache(Framework const &);
+
+    // Returns a copy of the first entry whose box contains the sample
+    std::optional<Entry> find(Network::Classification::Label, Network::SampleView);
+
+    // Explanations other than interval explanations are ignored
+    void insert(Network::Classification::Label, Explanation const &, Duration);
+
+    std::unique_ptr<IntervalExplanation> makeExplanation(Entry const &) const;
+
+    void addHit(Duration savedTime);
+    void addRejected();
+
+    Stats getStats() const;
+
+    void printStats(std::ostream &) const;
+
+protected:
+    // Entries inserted after the last build of the index are searched linearly
+    // The index is built again once there are this many of them
+    static constexpr std::size_t maxUnindexedSize = 4 * IntervalExplanationIndex::maxLeafSize;
+
+    struct Bucket {
+        Bucket(Framework const & fw) : index{fw} {}
+
+        // In the order of insertion, which is also the order of the boxes in the index
+        std::vector<Entry> entries{};
+        IntervalExplanationIndex index;
+        // No. entries covered by the last build of the index
+        std::size_t indexedSize{};
+    };
+
+    static bool contains(Entry const &, Network::SampleView);
+
+    Framework const & framework;
+
+    // Indexed by the class labels
+    std::vector<Bucket> buckets{};
+    mutable std::shared_mutex bucketsMtx{};
+
+    Stats stats{};
+    mutable std::mutex statsMtx{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_EXPAND_CACHE_H
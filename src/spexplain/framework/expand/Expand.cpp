@@ -4,12 +4,21 @@
 #include "../Preprocess.h"
 #include "../Print.h"
 #include "../explanation/Explanation.h"
+#include "../explanation/IntervalExplanation.h"
+#include "../explanation/VarBound.h"
+#include "Cache.h"
+#include "Journal.h"
+#include "Scheduler.h"
+#include "Writer.h"
 #include "strategy/Factory.h"
 #include "strategy/Strategies.h"
 
 #include <spexplain/common/Core.h>
+#include <spexplain/common/Profile.h>
 #include <spexplain/common/String.h>
 
+#include <verifiers/BoundPropagationVerifier.h>
+#include <verifiers/SplitClassificationVerifier.h>
 #include <verifiers/Verifier.h>
 #include <verifiers/opensmt/OpenSMTVerifier.h>
 #ifdef MARABOU
@@ -17,23 +26,41 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
 #include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 namespace spexplain {
 Framework::Expand::Expand(Framework & fw) : framework{fw} {}
 
+Framework::Expand::~Expand() = default;
+
 void Framework::Expand::setStrategies() {
     auto strategyPtr = std::make_unique<expand::opensmt::InterpolationStrategy>(*this);
-    addStrategy(std::move(strategyPtr));
+    addStrategy(std::move(strategyPtr), expand::opensmt::InterpolationStrategy::name());
 }
 
 void Framework::Expand::setStrategies(std::istream & is) {
+    // Kept s.t. the workers can instantiate their own strategies
+    strategiesSpec.assign(std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{});
+
+    std::istringstream iss{strategiesSpec};
+    parseStrategies(iss);
+}
+
+void Framework::Expand::parseStrategies(std::istream & is) {
     // pipe character '|' reserved for disjunctions
     static constexpr char strategyDelim = ';';
 
@@ -51,14 +78,18 @@ void Framework::Expand::setStrategies(std::istream & is) {
     std::string line;
     while (std::getline(is, line, strategyDelim)) {
         auto strategyPtr = factory.parse(line);
-        addStrategy(std::move(strategyPtr));
+        std::string name;
+        std::istringstream{line} >> name;
+        addStrategy(std::move(strategyPtr), toLower(name));
     }
 }
 
-void Framework::Expand::addStrategy(std::unique_ptr<Strategy> strategy) {
+void Framework::Expand::addStrategy(std::unique_ptr<Strategy> strategy, std::string name) {
     requiresSMTSolver |= strategy->requiresSMTSolver();
+    boundPropagationAllowed &= strategy->allowsBoundPropagation();
 
     strategies.push_back(std::move(strategy));
+    strategyNames.push_back(std::move(name));
 }
 
 std::unique_ptr<xai::verifiers::Verifier> Framework::Expand::makeVerifier(std::string_view name) const {
@@ -79,13 +110,35 @@ std::unique_ptr<xai::verifiers::Verifier> Framework::Expand::makeVerifier(std::s
 
 void Framework::Expand::setVerifier() {
     auto const & config = framework.getConfig();
-    auto verifierName = config.getVerifierName();
+    auto name = config.getVerifierName();
 
-    setVerifier(verifierName);
+    setVerifier(name);
 }
 
 void Framework::Expand::setVerifier(std::string_view name) {
-    setVerifier(makeVerifier(name));
+    auto vf = makeVerifier(name);
+
+    // Requires the strategies to be already set
+    auto const & config = framework.getConfig();
+    if (config.splittingClassification() and boundPropagationAllowed and not requiresSMTSolver) {
+        std::size_t const nVerifiers = config.getSplitClassificationVerifiers();
+        std::vector<std::unique_ptr<xai::verifiers::Verifier>> vfs;
+        vfs.reserve(nVerifiers);
+        vfs.push_back(std::move(vf));
+        while (vfs.size() < nVerifiers) {
+            vfs.push_back(makeVerifier(name));
+        }
+        // The decorator also proves the checks where no competing class remains
+        auto const bpType = config.usingBoundPropagation() ? config.getBoundPropagationType()
+                                                           : Network::BoundPropagation::Type::interval;
+        vf = std::make_unique<xai::verifiers::SplitClassificationVerifier>(std::move(vfs), bpType);
+    } else if (config.usingBoundPropagation() and boundPropagationAllowed and not requiresSMTSolver) {
+        vf = std::make_unique<xai::verifiers::BoundPropagationVerifier>(std::move(vf),
+                                                                         config.getBoundPropagationType());
+    }
+
+    setVerifier(std::move(vf));
+    verifierName = name;
 }
 
 void Framework::Expand::setVerifier(std::unique_ptr<xai::verifiers::Verifier> vf) {
@@ -93,6 +146,25 @@ void Framework::Expand::setVerifier(std::unique_ptr<xai::verifiers::Verifier> vf
     verifierPtr = std::move(vf);
 }
 
+std::unique_ptr<Framework::Expand> Framework::Expand::makeWorker() const {
+    auto workerPtr = std::make_unique<Expand>(framework);
+
+    std::istringstream iss{strategiesSpec};
+    workerPtr->setStrategies(iss);
+    workerPtr->setVerifier(verifierName);
+    workerPtr->cachePtr = cachePtr;
+
+    return workerPtr;
+}
+
+std::unique_ptr<Framework::Expand> Framework::Expand::makeVerifierWorker() const {
+    auto workerPtr = std::make_unique<Expand>(framework);
+
+    workerPtr->setVerifier(verifierName);
+
+    return workerPtr;
+}
+
 Network::Dataset::SampleIndices Framework::Expand::makeSampleIndices(Network::Dataset const & data) const {
     auto indices = getSampleIndices(data);
     assert(indices.size() <= data.size());
@@ -121,6 +193,20 @@ Network::Dataset::SampleIndices Framework::Expand::makeSampleIndices(Network::Da
     return indices;
 }
 
+std::vector<std::size_t> Framework::Expand::makeDispatchOrder(Network::Dataset const & data,
+                                                             Network::Dataset::SampleIndices const & indices) const {
+    std::vector<std::size_t> order(indices.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    auto const & config = framework.getConfig();
+    if (not config.schedulingSamplesByMargin()) { return order; }
+
+    // The smaller the margin, the longer it is expected to take, and such samples should start first
+    std::ranges::stable_sort(order, {}, [&](std::size_t pos) { return data.getComputedOutput(indices[pos]).margin; });
+
+    return order;
+}
+
 Network::Dataset::SampleIndices Framework::Expand::getSampleIndices(Network::Dataset const & data) const {
     auto const & config = framework.getConfig();
 
@@ -204,118 +290,430 @@ void Framework::Expand::operator()(Explanations & explanations, Network::Dataset
     }
 
     auto const & config = framework.getConfig();
-    bool const timeoutPerIsSet = config.timeLimitPerExplanationIsSet();
-    [[maybe_unused]]
-    auto const timeoutPer = config.getTimeLimitPerExplanation();
 
     auto & print = framework.getPrint();
     bool const printingInfo = not print.ignoringInfo();
-    bool const printingExplanations = not print.ignoringExplanations();
     bool const printingStats = not print.ignoringStats();
     bool const printingTimes = not print.ignoringTimes();
+    bool const printingRecords = not print.ignoringRecords();
     auto & cinfo = print.info();
-    auto & cexp = print.explanations();
     auto & cstats = print.stats();
-    auto & ctimes = print.times();
-    assert(printingExplanations);
+    assert(not print.ignoringExplanations());
 
     if (printingInfo) {
         cinfo << "Writing explanations to: " << config.getExplanationsFileName() << "\n";
         if (printingStats) { cinfo << "Writing statistics to: " << config.getStatsFileName() << "\n"; }
         if (printingTimes) { cinfo << "Writing runtimes per explanation to: " << config.getTimesFileName() << "\n"; }
+        if (printingRecords) { cinfo << "Writing records per sample to: " << config.getRecordsFileName() << "\n"; }
         cinfo << '\n';
         printHead(cinfo, data);
     }
 
-    if (printingStats) { printHead(cstats, data); }
+    journalPtr = std::make_unique<Journal>(framework, config.resuming());
+    auto & journal = *journalPtr;
 
-    auto const startTimeF = [printingTimes]() -> std::chrono::time_point<std::chrono::steady_clock> {
-        if (not printingTimes) { return {}; }
-        return std::chrono::steady_clock::now();
-    };
+    if (journal.isResumed()) {
+        if (printingInfo) { cinfo << "Resuming after " << journal.completedCount() << " completed samples\n\n"; }
+    } else {
+        if (printingStats) { printHead(cstats, data); }
+        journal.commitHead();
+    }
+
+    Network::Dataset::SampleIndices indices = makeSampleIndices(data);
+    std::erase_if(indices, [&journal](auto idx) { return journal.isCompleted(idx); });
+
+    // Must be set before the workers are created
+    if (config.reusingExplanations()) {
+        cachePtr = std::make_shared<Cache>(framework);
+    } else {
+        cachePtr.reset();
+    }
+
+    writerPtr = std::make_unique<Writer>(framework, journalPtr.get());
+
+    if (config.profiling()) { Profile::enable(config.tracing()); }
+
+    std::size_t const nThreads = std::min(config.getThreads(), indices.size());
+    if (nThreads > 1) {
+        explainParallel(explanations, data, indices, nThreads);
+    } else {
+        explainSequential(explanations, data, indices);
+    }
+
+    writerPtr->finish();
+    writerPtr.reset();
+
+    if (config.profiling()) { Profile::disable(); }
+
+    if (cachePtr) {
+        if (printingInfo) {
+            cinfo << '\n';
+            cachePtr->printStats(cinfo);
+        }
+        if (printingStats) {
+            cstats << '\n' << std::string(60, '-') << '\n';
+            cachePtr->printStats(cstats);
+        }
+    }
+
+    if (config.profiling()) {
+        if (printingInfo and config.isVerbose()) {
+            cinfo << '\n';
+            Profile::printStats(cinfo);
+        }
+        if (printingStats) {
+            cstats << '\n' << std::string(60, '-') << '\n';
+            Profile::printStats(cstats);
+        }
+    }
+
+    if (config.tracing()) {
+        std::string const traceFileName{config.getTraceFileName()};
+        std::ofstream traceOfs{traceFileName};
+        if (not traceOfs.good()) { throw std::ofstream::failure{"Could not open trace file: "s + traceFileName}; }
+        Profile::printTrace(traceOfs);
+        if (printingInfo) { cinfo << "\nWritten the trace of the phases to: " << traceFileName << '\n'; }
+    }
+
+    journalPtr.reset();
+
+    cinfo << "\nDone." << std::endl;
+}
+
+void Framework::Expand::explainSequential(Explanations & explanations, Network::Dataset const & data,
+                                          Network::Dataset::SampleIndices const & indices) {
+    auto & print = framework.getPrint();
+    bool const printingInfo = not print.ignoringInfo();
+    auto & cinfo = print.info();
 
     initVerifier();
 
     // Such incrementality does not seem to be beneficial
     // assertModel();
 
-    Network::Dataset::SampleIndices const indices = makeSampleIndices(data);
     for (auto idx : indices) {
-        [[maybe_unused]]
-        auto const start = startTimeF();
-
         if (printingInfo) {
             printProgress(cinfo, data, idx);
             cinfo << " ... ";
             cinfo.flush();
         }
 
-        bool timeout = false;
-        if (timeoutPerIsSet) { verifierPtr->setTimeLimit(timeoutPer); }
+        std::ostringstream explanationsOs;
+        std::ostringstream statsOs;
+        std::ostringstream timesOs;
+        std::ostringstream recordsOs;
+        bool const done = explainSample(explanations, data, idx, explanationsOs, statsOs, timesOs, recordsOs);
+        writerPtr->push({.idx = idx,
+                         .explanations = std::move(explanationsOs).str(),
+                         .stats = std::move(statsOs).str(),
+                         .times = std::move(timesOs).str(),
+                         .records = std::move(recordsOs).str()});
+
+        cinfo << (done ? "done" : "timeout") << std::endl;
+    }
+}
+
+void Framework::Expand::explainParallel(Explanations & explanations, Network::Dataset const & data,
+                                        Network::Dataset::SampleIndices const & indices, std::size_t nThreads) {
+    assert(nThreads > 1);
+    assert(nThreads <= indices.size());
+
+    auto & print = framework.getPrint();
+    bool const printingInfo = not print.ignoringInfo();
+    auto & cinfo = print.info();
 
-        // Seems quite more efficient than if outside the loop, at least with 'abductive'
-        assertModel();
+    // Each worker has its own verifier and strategies, the framework itself is only read
+    workers.clear();
+    workers.reserve(nThreads);
+    for (std::size_t i = 0; i < nThreads; ++i) {
+        auto & worker = *workers.emplace_back(makeWorker());
+        worker.initVerifier();
+    }
+
+    // The outputs are buffered per sample and passed to the writer in the order of the indices
+    struct Result {
+        std::ostringstream explanationsOs{};
+        std::ostringstream statsOs{};
+        std::ostringstream timesOs{};
+        std::ostringstream recordsOs{};
+        bool done{};
+        bool finished{};
+    };
 
-        auto const & output = data.getComputedOutput(idx);
-        auto const & cls = output.classification;
-        assertClassification(cls);
+    std::size_t const size = indices.size();
+    std::vector<Result> results(size);
+    Scheduler scheduler{nThreads, makeDispatchOrder(data, indices)};
+    std::atomic<bool> failed{false};
+    std::exception_ptr exceptionPtr{};
+    std::mutex mtx;
+    std::condition_variable finishedCv;
 
+    auto const work = [&](std::size_t workerIdx) {
+        auto & worker = *workers[workerIdx];
         try {
-            for (auto & strategy : strategies) {
-                strategy->execute(explanations, data, idx);
+            while (auto optPos = scheduler.next(workerIdx)) {
+                auto const pos = *optPos;
+                auto & res = results[pos];
+
+                auto const start = std::chrono::steady_clock::now();
+                bool const done = worker.explainSample(explanations, data, indices[pos], res.explanationsOs, res.statsOs,
+                                                       res.timesOs, res.recordsOs);
+                scheduler.addBusyTime(workerIdx, std::chrono::steady_clock::now() - start);
+
+                std::lock_guard lock{mtx};
+                res.done = done;
+                res.finished = true;
+                finishedCv.notify_all();
             }
-        } catch (UnknownResultInternalException) { timeout = true; }
-
-        assert(timeoutPerIsSet or not timeout);
-
-        if (not timeout) {
-            auto & explanation = getExplanation(explanations, idx);
-            cinfo << "done";
-            //+ get rid of the conditionals
-            if (printingStats) { printStatsOf(explanation, data, idx); }
-            if (printingExplanations) {
-                explanation.print(cexp);
-                cexp << std::endl;
+        } catch (...) {
+            scheduler.stop();
+            std::lock_guard lock{mtx};
+            if (not exceptionPtr) { exceptionPtr = std::current_exception(); }
+            failed = true;
+            finishedCv.notify_all();
+        }
+    };
+
+    auto const start = std::chrono::steady_clock::now();
+
+    std::vector<std::jthread> threads;
+    threads.reserve(nThreads);
+    for (std::size_t workerIdx = 0; workerIdx < nThreads; ++workerIdx) {
+        threads.emplace_back(work, workerIdx);
+    }
+
+    for (std::size_t pos = 0; pos < size; ++pos) {
+        auto & res = results[pos];
+        {
+            std::unique_lock lock{mtx};
+            finishedCv.wait(lock, [&res, &failed] { return res.finished or failed; });
+        }
+        if (not res.finished) { break; }
+
+        if (printingInfo) {
+            printProgress(cinfo, data, indices[pos]);
+            cinfo << " ... " << (res.done ? "done" : "timeout") << std::endl;
+        }
+
+        writerPtr->push({.idx = indices[pos],
+                         .explanations = std::move(res.explanationsOs).str(),
+                         .stats = std::move(res.statsOs).str(),
+                         .times = std::move(res.timesOs).str(),
+                         .records = std::move(res.recordsOs).str()});
+        res = {};
+    }
+
+    threads.clear();
+
+    if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+
+    if (printingInfo) {
+        cinfo << '\n';
+        scheduler.printUtilization(cinfo, std::chrono::steady_clock::now() - start);
+    }
+}
+
+bool Framework::Expand::explainSample(Explanations & explanations, Network::Dataset const & data, ExplanationIdx idx,
+                                      std::ostream & cexp, std::ostream & cstats, std::ostream & ctimes,
+                                      std::ostream & crecords) {
+    auto const & config = framework.getConfig();
+    bool const timeoutPerIsSet = config.timeLimitPerExplanationIsSet();
+
+    auto & print = framework.getPrint();
+    bool const printingExplanations = not print.ignoringExplanations();
+    bool const printingStats = not print.ignoringStats();
+    bool const printingTimes = not print.ignoringTimes();
+    bool const printingRecords = not print.ignoringRecords();
+    assert(printingExplanations);
+
+    // The cache also needs the times of the explanations
+    bool const measuringTime = printingTimes or printingRecords or cachePtr;
+    auto const startTimeF = [measuringTime]() -> std::chrono::time_point<std::chrono::steady_clock> {
+        if (not measuringTime) { return {}; }
+        return std::chrono::steady_clock::now();
+    };
+
+    [[maybe_unused]]
+    auto const start = startTimeF();
+
+    Profile::Scope const profileScope{"sample"};
+
+    bool timeout = false;
+    if (timeoutPerIsSet) { verifierPtr->setTimeLimit(config.getTimeLimitPerExplanation()); }
+
+    // Seems quite more efficient than if outside the loop, at least with 'abductive'
+    assertModel();
+
+    auto const & output = data.getComputedOutput(idx);
+    auto const & cls = output.classification;
+    assertClassification(cls);
+
+    // Otherwise a reused explanation would report the counts of the previous sample
+    for (auto & strategy : strategies) {
+        strategy->resetStats();
+    }
+
+    std::optional<std::chrono::duration<double>> optReusedDuration{};
+    if (cachePtr) {
+        Profile::Scope const reuseProfileScope{"reuse"};
+        optReusedDuration = tryReuseExplanation(explanations, data, idx);
+    }
+
+    SampleRecord record{};
+    try {
+        if (not optReusedDuration) {
+            std::size_t const nStrategies = strategies.size();
+            for (std::size_t strategyIdx = 0; strategyIdx < nStrategies; ++strategyIdx) {
+                [[maybe_unused]]
+                auto const strategyStart = startTimeF();
+                Profile::Scope const strategyProfileScope{strategyNames[strategyIdx].c_str()};
+                strategies[strategyIdx]->execute(explanations, data, idx);
+                if (printingRecords) { record.strategyDurations.push_back(startTimeF() - strategyStart); }
             }
+        }
+    } catch (UnknownResultInternalException) { timeout = true; }
+
+    assert(timeoutPerIsSet or not timeout);
+
+    if (cachePtr and not timeout) {
+        std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+        if (optReusedDuration) {
+            cachePtr->addHit(*optReusedDuration - duration);
         } else {
-            cinfo << "timeout";
-            if (printingStats) {
-                printStatsHeadOf(data, idx);
-                cstats << "<timeout>\n";
-            }
-            if (printingExplanations) {
-                //! the default format does not work if not yielding interval explanations
-                char const delim = config.getPrintingIntervalExplanationsDelim();
-                cexp << invalidExplanationString << delim << std::endl;
-            }
+            cachePtr->insert(cls.label, getExplanation(explanations, idx), duration);
         }
-        cinfo << std::endl;
+    }
+
+    if (not timeout) {
+        auto & explanation = getExplanation(explanations, idx);
+        //+ get rid of the conditionals
+        if (printingStats) {
+            printStatsOf(cstats, explanation, data, idx);
+            if (cachePtr) { cstats << "reused: " << (optReusedDuration ? "yes" : "no") << '\n'; }
+        }
+        if (printingExplanations) {
+            explanation.print(cexp);
+            cexp << '\n';
+        }
+    } else {
+        if (printingStats) {
+            printStatsHeadOf(cstats, data, idx);
+            cstats << "<timeout>\n";
+        }
+        if (printingExplanations) {
+            //! the default format does not work if not yielding interval explanations
+            char const delim = config.getPrintingIntervalExplanationsDelim();
+            cexp << invalidExplanationString << delim << '\n';
+        }
+    }
+
+    if (printingRecords) {
+        if (not timeout) { record.explanationPtr = &getExplanation(explanations, idx); }
+        if (cachePtr) { record.reused = optReusedDuration.has_value(); }
+        record.duration = startTimeF() - start;
+        printRecordOf(crecords, data, idx, record);
+    }
+
+    resetClassification();
 
-        resetClassification();
+    resetModel();
 
-        resetModel();
+    if (not printingTimes) { return not timeout; }
 
-        if (not printingTimes) { continue; }
+    if (not timeout) {
+        auto const finish = std::chrono::steady_clock::now();
+        std::chrono::duration<double> const duration = finish - start;
+        ctimes << std::setprecision(3) << duration.count();
+    } else {
+        ctimes << invalidExplanationString;
+    }
+    ctimes << '\n';
+
+    return not timeout;
+}
+
+std::optional<std::chrono::duration<double>>
+Framework::Expand::tryReuseExplanation(Explanations & explanations, Network::Dataset const & data,
+                                       ExplanationIdx idx) {
+    assert(cachePtr);
+
+    auto const & config = framework.getConfig();
+    auto const & label = data.getComputedOutput(idx).classification.label;
+
+    auto optEntry = cachePtr->find(label, data.getSample(idx));
+    if (not optEntry) { return std::nullopt; }
+
+    auto iexplanationPtr = cachePtr->makeExplanation(*optEntry);
+    if (config.verifyingReusedExplanations() and not checkReusedExplanation(*iexplanationPtr)) {
+        cachePtr->addRejected();
+        return std::nullopt;
+    }
+
+    getExplanationPtr(explanations, idx) = std::move(iexplanationPtr);
+    return optEntry->duration;
+}
+
+bool Framework::Expand::checkReusedExplanation(IntervalExplanation const & iexplanation) {
+    auto & verifier = *verifierPtr;
+
+    verifier.push();
+    std::size_t const esize = iexplanation.size();
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (not iexplanation.contains(idx)) { continue; }
 
-        if (not timeout) {
-            auto const finish = std::chrono::steady_clock::now();
-            std::chrono::duration<double> const duration = finish - start;
-            ctimes << std::setprecision(3) << duration.count();
+        Float const lo = iexplanation.getLower(idx);
+        Float const hi = iexplanation.getUpper(idx);
+        if (iexplanation.isPoint(idx)) {
+            verifier.addEquality(0, idx, lo);
+            continue;
+        }
+
+        bool const hasLower = iexplanation.hasLowerBound(idx);
+        bool const hasUpper = iexplanation.hasUpperBound(idx);
+        if (hasLower and hasUpper) {
+            verifier.addInterval(0, idx, lo, hi);
+        } else if (hasLower) {
+            verifier.addLowerBound(0, idx, lo);
         } else {
-            ctimes << invalidExplanationString;
+            assert(hasUpper);
+            verifier.addUpperBound(0, idx, hi);
         }
-        ctimes << std::endl;
     }
+    // A timeout just means that the explanation is computed anew
+    Profile::Scope const profileScope{"check"};
+    bool const ok = (verifier.check() == xai::verifiers::Verifier::Answer::UNSAT);
+    verifier.pop();
 
-    cinfo << "\nDone." << std::endl;
+    return ok;
 }
 
 void Framework::Expand::initVerifier() {
     assert(verifierPtr);
+
+    auto const & config = framework.getConfig();
+    if (config.usingBoundPropagation() and boundPropagationAllowed) {
+        std::vector<xai::verifiers::Verifier *> innerVerifierPtrs{verifierPtr.get()};
+        if (auto * bpVerifierPtr = dynamic_cast<xai::verifiers::BoundPropagationVerifier *>(verifierPtr.get())) {
+            innerVerifierPtrs = {&bpVerifierPtr->getInnerVerifier()};
+        } else if (auto * splitVerifierPtr =
+                       dynamic_cast<xai::verifiers::SplitClassificationVerifier *>(verifierPtr.get())) {
+            innerVerifierPtrs.clear();
+            for (std::size_t idx = 0; idx < splitVerifierPtr->nInnerVerifiers(); ++idx) {
+                innerVerifierPtrs.push_back(&splitVerifierPtr->getInnerVerifier(idx));
+            }
+        }
+        for (auto * innerVerifierPtr : innerVerifierPtrs) {
+            if (auto * opensmtVerifierPtr = dynamic_cast<xai::verifiers::OpenSMTVerifier *>(innerVerifierPtr)) {
+                opensmtVerifierPtr->setBoundPropagation(config.getBoundPropagationType());
+            }
+        }
+    }
+
     verifierPtr->init();
 }
 
 void Framework::Expand::assertModel() {
+    Profile::Scope const profileScope{"assertModel"};
     auto & network = framework.getNetwork();
     verifierPtr->loadModel(network);
 }
@@ -325,6 +723,7 @@ void Framework::Expand::resetModel() {
 }
 
 void Framework::Expand::assertClassification(Network::Classification const & cls) {
+    Profile::Scope const profileScope{"assertClassification"};
     verifierPtr->push();
 
     auto & network = framework.getNetwork();
@@ -391,19 +790,16 @@ void Framework::Expand::printProgress(std::ostream & os, Network::Dataset const
     os << caption << " [" << idx + 1 << '/' << dataSize << ']';
 }
 
-void Framework::Expand::printStatsOf(Explanation const & explanation, Network::Dataset const & data,
-                                     ExplanationIdx idx) const {
+void Framework::Expand::printStatsOf(std::ostream & cstats, Explanation const & explanation,
+                                     Network::Dataset const & data, ExplanationIdx idx) const {
 
-    printStatsHeadOf(data, idx);
-    printStatsBodyOf(explanation);
+    printStatsHeadOf(cstats, data, idx);
+    printStatsBodyOf(cstats, explanation);
 }
 
-void Framework::Expand::printStatsHeadOf(Network::Dataset const & data, ExplanationIdx idx) const {
-    auto & print = framework.getPrint();
-    assert(not print.ignoringStats());
-    auto & cstats = print.stats();
-
-    auto const & sample = data.getSample(idx);
+void Framework::Expand::printStatsHeadOf(std::ostream & cstats, Network::Dataset const & data,
+                                         ExplanationIdx idx) const {
+    auto const sample = data.getSample(idx);
     auto const & expClass = data.getExpectedClassification(idx).label;
     auto const & compClass = data.getComputedOutput(idx).classification.label;
 
@@ -412,13 +808,16 @@ void Framework::Expand::printStatsHeadOf(Network::Dataset const & data, Explanat
     cstats << ": " << sample << '\n';
     cstats << "expected output: " << expClass << '\n';
     cstats << "computed output: " << compClass << '\n';
-    cstats << "#checks: " << verifierPtr->getChecksCount() << '\n';
+    cstats << "#checks: " << getChecksCount() << '\n';
+    if (auto * bpVerifierPtr = dynamic_cast<xai::verifiers::BoundPropagationVerifier const *>(verifierPtr.get())) {
+        cstats << "#fast checks: " << bpVerifierPtr->getFastChecksCount() << '\n';
+    } else if (auto * splitVerifierPtr =
+                   dynamic_cast<xai::verifiers::SplitClassificationVerifier const *>(verifierPtr.get())) {
+        cstats << "#skipped classes: " << splitVerifierPtr->getSkippedOutputsCount() << '\n';
+    }
 }
 
-void Framework::Expand::printStatsBodyOf(Explanation const & explanation) const {
-    auto & print = framework.getPrint();
-    assert(not print.ignoringStats());
-    auto & cstats = print.stats();
+void Framework::Expand::printStatsBodyOf(std::ostream & cstats, Explanation const & explanation) const {
     auto const defaultPrecision = cstats.precision();
 
     std::size_t const varSize = framework.varSize();
@@ -455,4 +854,55 @@ void Framework::Expand::printStatsBodyOf(Explanation const & explanation) const
     cstats << "relVolume*: " << std::setprecision(1) << (relVolume * 100) << "%" << std::setprecision(defaultPrecision)
            << std::endl;
 }
+
+std::size_t Framework::Expand::getChecksCount() const {
+    std::size_t checksCount = verifierPtr->getChecksCount();
+    for (auto const & strategy : strategies) {
+        checksCount += strategy->getExtraChecksCount();
+    }
+    return checksCount;
+}
+
+void Framework::Expand::printRecordOf(std::ostream & os, Network::Dataset const & data, ExplanationIdx idx,
+                                      SampleRecord const & record) const {
+    auto const & expClass = data.getExpectedClassification(idx).label;
+    auto const & compClass = data.getComputedOutput(idx).classification.label;
+
+    // The sample number is the same as in the statistics, i.e. starting from 1
+    os << "{\"sample\":" << idx + 1;
+    os << ",\"expected\":" << expClass << ",\"computed\":" << compClass;
+    os << ",\"checks\":" << getChecksCount();
+    if (auto * bpVerifierPtr = dynamic_cast<xai::verifiers::BoundPropagationVerifier const *>(verifierPtr.get())) {
+        os << ",\"fastChecks\":" << bpVerifierPtr->getFastChecksCount();
+    } else if (auto * splitVerifierPtr =
+                   dynamic_cast<xai::verifiers::SplitClassificationVerifier const *>(verifierPtr.get())) {
+        os << ",\"skippedClasses\":" << splitVerifierPtr->getSkippedOutputsCount();
+    }
+
+    bool const timeout = not record.explanationPtr;
+    os << ",\"timeout\":" << (timeout ? "true" : "false");
+    if (not timeout) {
+        auto const & explanation = *record.explanationPtr;
+        os << ",\"features\":" << explanation.varSize() << ",\"vars\":" << framework.varSize();
+        os << ",\"fixed\":" << explanation.getFixedCount() << ",\"terms\":" << explanation.termSize();
+        if (explanation.supportsVolume()) {
+            os << ",\"relVolume\":";
+            printFloat(os, explanation.getRelativeVolumeSkipFixed());
+        }
+    }
+    if (record.reused) { os << ",\"reused\":" << (*record.reused ? "true" : "false"); }
+
+    os << ",\"time\":";
+    printFloat(os, record.duration.count());
+    os << ",\"strategies\":[";
+    std::size_t const executedCount = record.strategyDurations.size();
+    assert(executedCount <= strategyNames.size());
+    for (std::size_t i = 0; i < executedCount; ++i) {
+        if (i > 0) { os << ','; }
+        os << "{\"name\":\"" << strategyNames[i] << "\",\"time\":";
+        printFloat(os, record.strategyDurations[i].count());
+        os << '}';
+    }
+    os << "]}\n";
+}
 } // namespace spexplain
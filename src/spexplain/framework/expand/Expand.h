@@ -6,7 +6,11 @@
 #include <spexplain/common/Var.h>
 #include <spexplain/network/Dataset.h>
 
+#include <chrono>
+#include <iosfwd>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace xai::verifiers {
@@ -15,6 +19,7 @@ class Verifier;
 
 namespace spexplain {
 class Explanation;
+class IntervalExplanation;
 
 static_assert(std::is_same_v<ExplanationIdx, Network::Sample::Idx>);
 
@@ -31,6 +36,7 @@ public:
     class Strategy;
     class NopStrategy;
     class AbductiveStrategy;
+    class BisectAbductiveStrategy;
     class TrialAndErrorStrategy;
     class UnsatCoreStrategy;
     //! does not expand, it shrinks
@@ -41,6 +47,8 @@ public:
     static constexpr char const * invalidExplanationString = "<null>";
 
     Expand(Framework &);
+    // Not inline because of fwd-decl. types
+    ~Expand();
 
     Framework const & getFramework() const { return framework; }
 
@@ -64,17 +72,54 @@ public:
 
     void operator()(Explanations &, Network::Dataset const &);
 
+    // Another instance with its own verifier and strategies, sharing the framework
+    std::unique_ptr<Expand> makeWorker() const;
+    // Another instance with just its own verifier, e.g. for checks run by a strategy in parallel
+    std::unique_ptr<Expand> makeVerifierWorker() const;
+
+    void initVerifier();
+
+    // Returns false on timeout
+    bool explainSample(Explanations &, Network::Dataset const &, ExplanationIdx, std::ostream & explanationsOs,
+                       std::ostream & statsOs, std::ostream & timesOs, std::ostream & recordsOs);
+
 protected:
+    class Scheduler;
+    class Cache;
+    class Journal;
+    class Writer;
+
     struct UnknownResultInternalException {};
 
-    void addStrategy(std::unique_ptr<Strategy>);
+    // Outcome of a sample that is not available from the explanation itself
+    struct SampleRecord {
+        // Null on timeout
+        Explanation const * explanationPtr{};
+        std::optional<bool> reused{};
+        std::chrono::duration<double> duration{};
+        // Only of the strategies that finished, in their order
+        std::vector<std::chrono::duration<double>> strategyDurations{};
+    };
+
+    void addStrategy(std::unique_ptr<Strategy>, std::string name);
+
+    void parseStrategies(std::istream &);
 
     std::unique_ptr<xai::verifiers::Verifier> makeVerifier(std::string_view name) const;
     void setVerifier(std::unique_ptr<xai::verifiers::Verifier>);
 
     Network::Dataset::SampleIndices makeSampleIndices(Network::Dataset const &) const;
+    // Positions within the sample indices in the order in which they are handed to the workers
+    std::vector<std::size_t> makeDispatchOrder(Network::Dataset const &, Network::Dataset::SampleIndices const &) const;
 
-    void initVerifier();
+    void explainSequential(Explanations &, Network::Dataset const &, Network::Dataset::SampleIndices const &);
+    void explainParallel(Explanations &, Network::Dataset const &, Network::Dataset::SampleIndices const &,
+                         std::size_t nThreads);
+
+    // Returns the time it took to compute the reused explanation
+    std::optional<std::chrono::duration<double>> tryReuseExplanation(Explanations &, Network::Dataset const &,
+                                                                     ExplanationIdx);
+    bool checkReusedExplanation(IntervalExplanation const &);
 
     void assertModel();
     void resetModel();
@@ -86,17 +131,37 @@ protected:
     void printProgress(std::ostream &, Network::Dataset const &, ExplanationIdx,
                        std::string_view caption = "sample") const;
 
-    void printStatsOf(Explanation const &, Network::Dataset const &, ExplanationIdx) const;
-    void printStatsHeadOf(Network::Dataset const &, ExplanationIdx) const;
-    void printStatsBodyOf(Explanation const &) const;
+    void printStatsOf(std::ostream &, Explanation const &, Network::Dataset const &, ExplanationIdx) const;
+    void printStatsHeadOf(std::ostream &, Network::Dataset const &, ExplanationIdx) const;
+    void printStatsBodyOf(std::ostream &, Explanation const &) const;
+
+    // Including the checks of the strategies that were not run by the verifier
+    std::size_t getChecksCount() const;
+
+    // A single line in the JSON format
+    void printRecordOf(std::ostream &, Network::Dataset const &, ExplanationIdx, SampleRecord const &) const;
 
     Framework & framework;
 
     std::unique_ptr<xai::verifiers::Verifier> verifierPtr{};
+    std::string verifierName{};
 
     Strategies strategies{};
+    std::vector<std::string> strategyNames{};
+    std::string strategiesSpec{};
 
     bool requiresSMTSolver{false};
+    bool boundPropagationAllowed{true};
+
+    // Kept alive with the explanations that may refer to their verifiers
+    std::vector<std::unique_ptr<Expand>> workers{};
+
+    // Shared with the workers
+    std::shared_ptr<Cache> cachePtr{};
+
+    // Only within the main instance
+    std::unique_ptr<Journal> journalPtr{};
+    std::unique_ptr<Writer> writerPtr{};
 
 private:
     Network::Dataset::SampleIndices getSampleIndices(Network::Dataset const &) const;
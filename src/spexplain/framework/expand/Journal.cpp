@@ -0,0 +1,126 @@
+#include "Journal.h"
+
+#include "../Config.h"
+#include "../Print.h"
+
+#include <spexplain/common/String.h>
+
+#include <cassert>
+#include <filesystem>
+#include <sstream>
+
+namespace spexplain {
+namespace {
+    std::uintmax_t fileSize(std::string_view fileName) {
+        std::error_code ec;
+        auto const size = std::filesystem::file_size(fileName, ec);
+        // The file may not exist yet
+        if (ec) { return 0; }
+        return size;
+    }
+} // namespace
+
+Framework::Expand::Journal::Journal(Framework const & fw, bool resuming)
+    : framework{fw},
+      fileName{std::string{fw.getPrint().getExplanationsFileName()} + fileNameSuffix} {
+    if (not resuming) {
+        os = std::ofstream{fileName};
+    } else {
+        std::uintmax_t const validSize = readPrevious();
+        // A partially written last line is discarded
+        if (std::filesystem::exists(fileName)) { std::filesystem::resize_file(fileName, validSize); }
+        truncateOutputs(lastOffsets);
+        os = std::ofstream{fileName, std::ios::app};
+    }
+
+    if (not os.good()) { throw std::ofstream::failure{"Could not open journal file: "s + fileName}; }
+}
+
+std::uintmax_t Framework::Expand::Journal::readPrevious() {
+    std::ifstream ifs{fileName};
+    if (not ifs.good()) { return 0; }
+
+    std::uintmax_t validSize = 0;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (ifs.eof()) { break; }
+
+        std::istringstream iss{line};
+        std::string tag;
+        ExplanationIdx idx{};
+        Offsets offsets;
+        iss >> tag;
+        bool const isSample = (tag == sampleTag);
+        if (isSample) { iss >> idx; }
+        iss >> offsets.explanations >> offsets.stats >> offsets.times >> offsets.records;
+        if (iss.fail() or not (isSample or tag == headTag)) { break; }
+
+        resumed = true;
+        lastOffsets = offsets;
+        if (isSample) { completedIndices.insert(idx); }
+        validSize += line.size() + 1;
+    }
+
+    return validSize;
+}
+
+Framework::Expand::Journal::Offsets Framework::Expand::Journal::currentOffsets() const {
+    auto const & print = framework.getPrint();
+
+    Offsets offsets;
+    if (not print.ignoringExplanations()) {
+        print.explanations().flush();
+        offsets.explanations = fileSize(print.getExplanationsFileName());
+    }
+    if (not print.ignoringStats()) {
+        print.stats().flush();
+        offsets.stats = fileSize(print.getStatsFileName());
+    }
+    if (not print.ignoringTimes()) {
+        print.times().flush();
+        offsets.times = fileSize(print.getTimesFileName());
+    }
+    if (not print.ignoringRecords()) {
+        print.records().flush();
+        offsets.records = fileSize(print.getRecordsFileName());
+    }
+
+    return offsets;
+}
+
+void Framework::Expand::Journal::truncateOutputs(Offsets const & offsets) const {
+    auto const & print = framework.getPrint();
+
+    // The outputs are opened for appending and nothing has been written yet
+    auto truncate = [](std::string_view outputFileName, std::uintmax_t size) {
+        if (fileSize(outputFileName) > size) { std::filesystem::resize_file(outputFileName, size); }
+    };
+
+    if (not print.ignoringExplanations()) { truncate(print.getExplanationsFileName(), offsets.explanations); }
+    if (not print.ignoringStats()) { truncate(print.getStatsFileName(), offsets.stats); }
+    if (not print.ignoringTimes()) { truncate(print.getTimesFileName(), offsets.times); }
+    if (not print.ignoringRecords()) { truncate(print.getRecordsFileName(), offsets.records); }
+}
+
+void Framework::Expand::Journal::commitHead() {
+    write(headTag, currentOffsets());
+    flush();
+}
+
+void Framework::Expand::Journal::commitSample(ExplanationIdx idx, Offsets const & sizes) {
+    Offsets const offsets{.explanations = lastOffsets.explanations + sizes.explanations,
+                          .stats = lastOffsets.stats + sizes.stats,
+                          .times = lastOffsets.times + sizes.times,
+                          .records = lastOffsets.records + sizes.records};
+    write(sampleTag, offsets, std::to_string(idx));
+    completedIndices.insert(idx);
+}
+
+void Framework::Expand::Journal::write(std::string_view tag, Offsets const & offsets, std::string_view idxStr) {
+    os << tag;
+    if (not idxStr.empty()) { os << ' ' << idxStr; }
+    os << ' ' << offsets.explanations << ' ' << offsets.stats << ' ' << offsets.times << ' ' << offsets.records
+       << '\n';
+    lastOffsets = offsets;
+}
+} // namespace spexplain
@@ -0,0 +1,68 @@
+#ifndef SPEXPLAIN_EXPAND_JOURNAL_H
+#define SPEXPLAIN_EXPAND_JOURNAL_H
+
+#include "Expand.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace spexplain {
+// Progress of a run, written alongside the output files, which allows to resume the run after it was interrupted
+// Each line records the sizes of the output files after the heads or after a completed sample,
+// so that on resume, anything written after the last record is discarded and the outputs stay consistent
+class Framework::Expand::Journal {
+public:
+    static constexpr char const * fileNameSuffix = ".journal";
+
+    // If resuming, reads the previous journal and truncates the outputs to its last record
+    Journal(Framework const &, bool resuming);
+
+    // Whether the previous run got past the heads, so they must not be printed again
+    bool isResumed() const { return resumed; }
+
+    std::size_t completedCount() const { return completedIndices.size(); }
+    bool isCompleted(ExplanationIdx idx) const { return completedIndices.contains(idx); }
+
+    struct Offsets {
+        std::uintmax_t explanations{};
+        std::uintmax_t stats{};
+        std::uintmax_t times{};
+        std::uintmax_t records{};
+    };
+
+    void commitHead();
+    // The sizes of the outputs of the sample, which must follow right after the previous record
+    // The record is written only once flushed, which must be after the outputs themselves are flushed
+    void commitSample(ExplanationIdx, Offsets const & sizes);
+
+    void flush() { os.flush(); }
+
+protected:
+    static constexpr std::string_view headTag = "head";
+    static constexpr std::string_view sampleTag = "sample";
+
+    // Returns the size of the valid part of the journal
+    std::uintmax_t readPrevious();
+
+    // Flushes the outputs first
+    Offsets currentOffsets() const;
+
+    void truncateOutputs(Offsets const &) const;
+
+    void write(std::string_view tag, Offsets const &, std::string_view idxStr = "");
+
+    Framework const & framework;
+
+    std::string fileName;
+    std::ofstream os{};
+
+    bool resumed{};
+    Offsets lastOffsets{};
+    std::unordered_set<ExplanationIdx> completedIndices{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_EXPAND_JOURNAL_H
@@ -0,0 +1,93 @@
+#include "Scheduler.h"
+
+#include <cassert>
+#include <iomanip>
+#include <ostream>
+
+namespace spexplain {
+Framework::Expand::Scheduler::Scheduler(std::size_t nWorkers_, Positions const & dispatchOrder) {
+    assert(nWorkers_ > 0);
+
+    queues.reserve(nWorkers_);
+    for (std::size_t i = 0; i < nWorkers_; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    workerStats.resize(nWorkers_);
+
+    // Round-robin, s.t. the first positions in the order are taken first by all the workers
+    std::size_t worker = 0;
+    for (Pos pos : dispatchOrder) {
+        queues[worker]->positions.push_back(pos);
+        if (++worker == nWorkers_) { worker = 0; }
+    }
+}
+
+std::optional<Framework::Expand::Scheduler::Pos> Framework::Expand::Scheduler::next(std::size_t worker) {
+    assert(worker < nWorkers());
+
+    if (auto optPos = popFront(worker)) {
+        ++workerStats[worker].nSamples;
+        return optPos;
+    }
+
+    if (auto optPos = stealBack(worker)) {
+        auto & stats = workerStats[worker];
+        ++stats.nSamples;
+        ++stats.nStolen;
+        return optPos;
+    }
+
+    return std::nullopt;
+}
+
+void Framework::Expand::Scheduler::stop() {
+    for (auto & queuePtr : queues) {
+        std::lock_guard lock{queuePtr->mtx};
+        queuePtr->positions.clear();
+    }
+}
+
+std::optional<Framework::Expand::Scheduler::Pos> Framework::Expand::Scheduler::popFront(std::size_t worker) {
+    auto & queue = *queues[worker];
+    std::lock_guard lock{queue.mtx};
+    auto & positions = queue.positions;
+    if (positions.empty()) { return std::nullopt; }
+
+    Pos const pos = positions.front();
+    positions.pop_front();
+    return pos;
+}
+
+std::optional<Framework::Expand::Scheduler::Pos> Framework::Expand::Scheduler::stealBack(std::size_t worker) {
+    std::size_t const n = nWorkers();
+    // Taking from the back leaves the supposedly longer ones to the owner
+    for (std::size_t i = 1; i < n; ++i) {
+        auto & queue = *queues[(worker + i) % n];
+        std::lock_guard lock{queue.mtx};
+        auto & positions = queue.positions;
+        if (positions.empty()) { continue; }
+
+        Pos const pos = positions.back();
+        positions.pop_back();
+        return pos;
+    }
+
+    return std::nullopt;
+}
+
+void Framework::Expand::Scheduler::printUtilization(std::ostream & os,
+                                                    std::chrono::duration<double> const & wallTime) const {
+    auto const defaultPrecision = os.precision();
+    double const wallTime_s = wallTime.count();
+
+    os << "Utilization of workers:\n";
+    for (std::size_t worker = 0; worker < nWorkers(); ++worker) {
+        auto const & stats = workerStats[worker];
+        double const busyTime_s = stats.busyTime.count();
+        double const utilization = (wallTime_s > 0) ? (busyTime_s / wallTime_s) : 0;
+        os << "worker " << worker << ": " << std::fixed << std::setprecision(1) << (utilization * 100) << "%"
+           << std::defaultfloat << std::setprecision(defaultPrecision) << " (#samples: " << stats.nSamples
+           << ", #stolen: " << stats.nStolen << ")\n";
+    }
+}
+} // namespace spexplain
@@ -0,0 +1,61 @@
+#ifndef SPEXPLAIN_EXPAND_SCHEDULER_H
+#define SPEXPLAIN_EXPAND_SCHEDULER_H
+
+#include "Expand.h"
+
+#include <chrono>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace spexplain {
+// Distributes positions of the sample indices among workers using work-stealing deques
+class Framework::Expand::Scheduler {
+public:
+    using Pos = std::size_t;
+    using Positions = std::vector<Pos>;
+
+    struct WorkerStats {
+        std::size_t nSamples{};
+        std::size_t nStolen{};
+        std::chrono::duration<double> busyTime{};
+    };
+
+    // The positions are dispatched in the given order (which is not necessarily the order of the output)
+    Scheduler(std::size_t nWorkers, Positions const & dispatchOrder);
+
+    std::size_t nWorkers() const { return queues.size(); }
+
+    // Takes the next position of the worker or steals one from the others, if empty then there is nothing left
+    std::optional<Pos> next(std::size_t worker);
+
+    void stop();
+
+    void addBusyTime(std::size_t worker, std::chrono::duration<double> const & duration) {
+        workerStats[worker].busyTime += duration;
+    }
+
+    std::vector<WorkerStats> const & getWorkerStats() const { return workerStats; }
+
+    void printUtilization(std::ostream &, std::chrono::duration<double> const & wallTime) const;
+
+protected:
+    struct Queue {
+        std::mutex mtx{};
+        std::deque<Pos> positions{};
+    };
+
+    std::optional<Pos> popFront(std::size_t worker);
+    std::optional<Pos> stealBack(std::size_t worker);
+
+    std::vector<std::unique_ptr<Queue>> queues{};
+
+    // Each element is accessed only by the corresponding worker
+    std::vector<WorkerStats> workerStats{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_EXPAND_SCHEDULER_H
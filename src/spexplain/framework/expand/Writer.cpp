@@ -0,0 +1,100 @@
+#include "Writer.h"
+
+#include "../Print.h"
+#include "Journal.h"
+
+#include <cassert>
+#include <ostream>
+
+namespace spexplain {
+Framework::Expand::Writer::Writer(Framework const & fw, Journal * jPtr) : framework{fw}, journalPtr{jPtr} {
+    thread = std::jthread{[this] { work(); }};
+}
+
+Framework::Expand::Writer::~Writer() {
+    // Must not throw, the exception is lost if finish() was not called
+    try {
+        finish();
+    } catch (...) {}
+}
+
+void Framework::Expand::Writer::push(Record record) {
+    std::lock_guard lock{mtx};
+    assert(not finishing);
+    if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+    pending.push_back(std::move(record));
+    pendingCv.notify_one();
+}
+
+void Framework::Expand::Writer::finish() {
+    {
+        std::lock_guard lock{mtx};
+        finishing = true;
+        pendingCv.notify_one();
+    }
+
+    if (thread.joinable()) { thread.join(); }
+
+    if (exceptionPtr) { std::rethrow_exception(std::exchange(exceptionPtr, nullptr)); }
+}
+
+void Framework::Expand::Writer::work() {
+    std::vector<Record> batch;
+    while (true) {
+        {
+            std::unique_lock lock{mtx};
+            pendingCv.wait(lock, [this] { return not pending.empty() or finishing; });
+            if (pending.empty()) {
+                assert(finishing);
+                return;
+            }
+            batch.swap(pending);
+        }
+
+        try {
+            writeBatch(batch);
+        } catch (...) {
+            std::lock_guard lock{mtx};
+            exceptionPtr = std::current_exception();
+            return;
+        }
+        batch.clear();
+    }
+}
+
+void Framework::Expand::Writer::writeBatch(std::vector<Record> const & batch) {
+    auto const & print = framework.getPrint();
+    bool const printingExplanations = not print.ignoringExplanations();
+    bool const printingStats = not print.ignoringStats();
+    bool const printingTimes = not print.ignoringTimes();
+    bool const printingRecords = not print.ignoringRecords();
+    auto & cexp = print.explanations();
+    auto & cstats = print.stats();
+    auto & ctimes = print.times();
+    auto & crecords = print.records();
+
+    for (auto const & [_, explanations, stats, times, records] : batch) {
+        if (printingExplanations) { cexp.write(explanations.data(), explanations.size()); }
+        if (printingStats) { cstats.write(stats.data(), stats.size()); }
+        if (printingTimes) { ctimes.write(times.data(), times.size()); }
+        if (printingRecords) { crecords.write(records.data(), records.size()); }
+    }
+
+    // The outputs must be complete before the journal claims so
+    if (printingExplanations) { cexp.flush(); }
+    if (printingStats) { cstats.flush(); }
+    if (printingTimes) { ctimes.flush(); }
+    if (printingRecords) { crecords.flush(); }
+
+    if (not journalPtr) { return; }
+
+    for (auto const & [idx, explanations, stats, times, records] : batch) {
+        journalPtr->commitSample(idx,
+                                 {.explanations = explanations.size(),
+                                  .stats = stats.size(),
+                                  .times = times.size(),
+                                  .records = records.size()});
+    }
+    journalPtr->flush();
+}
+} // namespace spexplain
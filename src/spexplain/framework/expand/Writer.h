@@ -0,0 +1,54 @@
+#ifndef SPEXPLAIN_EXPAND_WRITER_H
+#define SPEXPLAIN_EXPAND_WRITER_H
+
+#include "Expand.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spexplain {
+// Writes the already formatted outputs of the samples into the output files from a background thread,
+// so that the explaining never waits for the I/O
+// The records are written in the order in which they are pushed, and in batches,
+// each of which is flushed and only then committed into the journal, if any
+class Framework::Expand::Writer {
+public:
+    struct Record {
+        ExplanationIdx idx;
+        std::string explanations;
+        std::string stats;
+        std::string times;
+        std::string records;
+    };
+
+    Writer(Framework const &, Journal *);
+    ~Writer();
+
+    void push(Record);
+
+    // Blocks until all the records are written
+    void finish();
+
+protected:
+    void work();
+
+    void writeBatch(std::vector<Record> const &);
+
+    Framework const & framework;
+    Journal * journalPtr;
+
+    std::mutex mtx{};
+    std::condition_variable pendingCv{};
+    std::vector<Record> pending{};
+    bool finishing{};
+    std::exception_ptr exceptionPtr{};
+
+    std::jthread thread{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_EXPAND_WRITER_H
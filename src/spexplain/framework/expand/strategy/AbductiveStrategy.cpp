@@ -16,11 +16,19 @@ void Framework::Expand::AbductiveStrategy::executeBody(Explanations & explanatio
 
     auto & verifier = getVerifier();
 
+    bool const assuming = usingAssumptions();
+    if (assuming) { assertGuardedIntervalExplanation(iexplanation); }
+
     for (VarIdx idxToOmit : varOrdering.order) {
-        verifier.push();
-        assertIntervalExplanationExcept(iexplanation, idxToOmit, {.ignoreVarOrder = true});
-        bool const ok = checkFormsExplanation();
-        verifier.pop();
+        bool ok;
+        if (assuming) {
+            ok = checkFormsExplanationAssumingExcept(iexplanation, idxToOmit);
+        } else {
+            verifier.push();
+            assertIntervalExplanationExcept(iexplanation, idxToOmit, {.ignoreVarOrder = true});
+            ok = checkFormsExplanation();
+            verifier.pop();
+        }
         // It is no longer explanation after the removal -> we cannot remove it
         if (not ok) { continue; }
         iexplanation.eraseVarBound(idxToOmit);
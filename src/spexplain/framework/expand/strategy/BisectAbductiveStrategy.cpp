@@ -0,0 +1,106 @@
+#include "BisectAbductiveStrategy.h"
+
+#include <spexplain/framework/explanation/IntervalExplanation.h>
+#include <spexplain/framework/explanation/VarBound.h>
+
+#include <verifiers/Verifier.h>
+
+#include <cassert>
+
+namespace spexplain {
+void Framework::Expand::BisectAbductiveStrategy::executeBody(Explanations & explanations, Network::Dataset const &,
+                                                             ExplanationIdx idx) {
+    auto & explanation = getExplanation(explanations, idx);
+    assert(dynamic_cast<IntervalExplanation *>(&explanation));
+    auto & iexplanation = static_cast<IntervalExplanation &>(explanation);
+
+    // Already eliminated features are skipped
+    std::vector<VarIdx> varsToOmit;
+    varsToOmit.reserve(varOrdering.order.size());
+    for (VarIdx idxToOmit : varOrdering.order) {
+        if (not iexplanation.contains(idxToOmit)) { continue; }
+        varsToOmit.push_back(idxToOmit);
+    }
+
+    inBlock.assign(iexplanation.size(), false);
+
+    if (usingAssumptions()) { assertGuardedIntervalExplanation(iexplanation); }
+
+    eraseBlock(iexplanation, varsToOmit);
+}
+
+// If the elimination of a block succeeds, the sequential elimination of its features would also succeed,
+// hence the result is equal to the one of the abductive strategy using the same order of features
+bool Framework::Expand::BisectAbductiveStrategy::eraseBlock(IntervalExplanation & iexplanation,
+                                                            std::span<VarIdx const> block, bool knownToFail) {
+    if (block.empty()) { return true; }
+
+    if (not knownToFail) {
+        auto & verifier = getVerifier();
+
+        for (VarIdx idx : block) {
+            inBlock[idx] = true;
+        }
+        bool ok;
+        if (usingAssumptions()) {
+            ok = checkFormsExplanationAssuming(makeGuardsExceptBlock(iexplanation));
+        } else {
+            verifier.push();
+            assertIntervalExplanationExceptBlock(iexplanation);
+            ok = checkFormsExplanation();
+            verifier.pop();
+        }
+        for (VarIdx idx : block) {
+            inBlock[idx] = false;
+        }
+
+        if (ok) {
+            for (VarIdx idx : block) {
+                iexplanation.eraseVarBound(idx);
+            }
+            return true;
+        }
+    }
+
+    // It is no longer explanation after the removal of the single feature -> we cannot remove it
+    if (block.size() == 1) { return false; }
+
+    std::size_t const half = block.size() / 2;
+    bool const firstErased = eraseBlock(iexplanation, block.first(half));
+    // The whole block failed, so if the first half was eliminated, the second one must fail as a whole
+    eraseBlock(iexplanation, block.subspan(half), firstErased);
+    return false;
+}
+
+void Framework::Expand::BisectAbductiveStrategy::assertIntervalExplanationExceptBlock(
+    IntervalExplanation const & iexplanation) {
+    std::size_t const esize = iexplanation.size();
+    assert(inBlock.size() == esize);
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (inBlock[idx]) { continue; }
+
+        if (not iexplanation.contains(idx)) { continue; }
+
+        assertVarBound(iexplanation, idx);
+    }
+}
+
+std::vector<Framework::Expand::Strategy::Guard>
+Framework::Expand::BisectAbductiveStrategy::makeGuardsExceptBlock(IntervalExplanation const & iexplanation) const {
+    std::size_t const esize = iexplanation.size();
+    assert(inBlock.size() == esize);
+    assert(varGuards.size() == esize);
+
+    std::vector<Guard> guards;
+    guards.reserve(esize);
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (inBlock[idx]) { continue; }
+        if (not iexplanation.contains(idx)) { continue; }
+
+        assert(varGuards[idx] != invalidGuard);
+        guards.push_back(varGuards[idx]);
+    }
+
+    return guards;
+}
+} // namespace spexplain
@@ -0,0 +1,33 @@
+#ifndef SPEXPLAIN_EXPAND_BISECTABDUCTIVESTRATEGY_H
+#define SPEXPLAIN_EXPAND_BISECTABDUCTIVESTRATEGY_H
+
+#include "Strategy.h"
+
+#include <span>
+#include <vector>
+
+namespace spexplain {
+// Yields the same explanation as the abductive strategy, but tries to eliminate whole blocks of features at once
+// and bisects only the blocks that cannot be eliminated (similarly to QuickXplain)
+class Framework::Expand::BisectAbductiveStrategy : public Strategy {
+public:
+    using Strategy::Strategy;
+
+    static char const * name() { return "bisect"; }
+
+protected:
+    void executeBody(Explanations &, Network::Dataset const &, ExplanationIdx) override;
+
+    // Returns true if the whole block was eliminated
+    // If `knownToFail`, the elimination of the whole block is not even tried
+    bool eraseBlock(IntervalExplanation &, std::span<VarIdx const> block, bool knownToFail = false);
+
+    void assertIntervalExplanationExceptBlock(IntervalExplanation const &);
+    std::vector<Guard> makeGuardsExceptBlock(IntervalExplanation const &) const;
+
+    // Whether the variable is within the currently checked block
+    std::vector<bool> inBlock{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_EXPAND_BISECTABDUCTIVESTRATEGY_H
@@ -31,8 +31,12 @@ std::unique_ptr<Framework::Expand::Strategy> Framework::Expand::Strategy::Factor
 
     if (nameLower == NopStrategy::name()) { return parseDefault<NopStrategy>(str, params); }
     if (nameLower == AbductiveStrategy::name()) { return parseDefault<AbductiveStrategy>(str, params); }
+    if (nameLower == BisectAbductiveStrategy::name()) { return parseDefault<BisectAbductiveStrategy>(str, params); }
     if (nameLower == TrialAndErrorStrategy::name()) { return parseTrial(str, params); }
     if (nameLower == expand::opensmt::UnsatCoreStrategy::name()) { return parseUnsatCore(str, params); }
+    if (nameLower == expand::opensmt::UnsatCoreAbductiveStrategy::name()) {
+        return parseUnsatCoreAbductive(str, params);
+    }
     if (nameLower == expand::opensmt::InterpolationStrategy::name()) { return parseInterpolation(str, params); }
     if (nameLower == SliceStrategy::name()) { return parseSlice(str, params); }
 
@@ -109,6 +113,10 @@ std::unique_ptr<Framework::Expand::Strategy> Framework::Expand::Strategy::Factor
             if (paramLower == "n") {
                 if (iss >> conf.maxAttempts) { continue; }
             }
+            if (paramLower == "parallel") {
+                conf.parallel = true;
+                continue;
+            }
         }
 
         throwInvalidParameterTp<TrialAndErrorStrategy>(paramStr);
@@ -153,6 +161,31 @@ Framework::Expand::Strategy::Factory::parseUnsatCore(std::string const & str, au
     return parseReturnTp<UnsatCoreStrategy>(str, params, baseConf, conf);
 }
 
+std::unique_ptr<Framework::Expand::Strategy>
+Framework::Expand::Strategy::Factory::parseUnsatCoreAbductive(std::string const & str, auto & params) {
+    using expand::opensmt::UnsatCoreAbductiveStrategy;
+
+    UnsatCoreAbductiveStrategy::Config conf;
+    while (not params.empty()) {
+        std::string const paramStr = std::move(params.front());
+        std::istringstream iss{paramStr};
+        params.pop();
+        std::string param;
+        iss >> param;
+        if (not iss) { throwInvalidParameterTp<UnsatCoreAbductiveStrategy>(paramStr); }
+        auto const paramLower = toLower(param);
+
+        if (paramLower == "min") {
+            conf.minimal = true;
+            continue;
+        }
+
+        throwInvalidParameterTp<UnsatCoreAbductiveStrategy>(param);
+    }
+
+    return parseReturnTp<UnsatCoreAbductiveStrategy>(str, params, conf);
+}
+
 std::unique_ptr<Framework::Expand::Strategy>
 Framework::Expand::Strategy::Factory::parseInterpolation(std::string const & str, auto & params) {
     using expand::opensmt::InterpolationStrategy;
@@ -43,6 +43,7 @@ private:
     std::unique_ptr<Strategy> parseDefault(std::string const &, auto & params);
     std::unique_ptr<Strategy> parseTrial(std::string const &, auto & params);
     std::unique_ptr<Strategy> parseUnsatCore(std::string const &, auto & params);
+    std::unique_ptr<Strategy> parseUnsatCoreAbductive(std::string const &, auto & params);
     std::unique_ptr<Strategy> parseInterpolation(std::string const &, auto & params);
     std::unique_ptr<Strategy> parseSlice(std::string const &, auto & params);
 };
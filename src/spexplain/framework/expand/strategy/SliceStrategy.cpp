@@ -11,7 +11,7 @@ void Framework::Expand::SliceStrategy::executeBody(Explanations & explanations,
     auto & fw = expand.getFramework();
     auto & preprocess = fw.getPreprocess();
 
-    auto & sample = data.getSample(idx);
+    auto const sample = data.getSample(idx);
     auto sampleExpPtr = preprocess.makeExplanationFromSample(sample);
     assert(dynamic_cast<IntervalExplanation *>(sampleExpPtr.get()));
     auto & sampleExp = static_cast<IntervalExplanation &>(*sampleExpPtr);
@@ -5,11 +5,13 @@
 
 #include "NopStrategy.h"
 #include "AbductiveStrategy.h"
+#include "BisectAbductiveStrategy.h"
 #include "TrialAndErrorStrategy.h"
 #include "UnsatCoreStrategy.h"
 #include "SliceStrategy.h"
 #include "opensmt/InterpolationStrategy.h"
 #include "opensmt/UnsatCoreStrategy.h"
+#include "opensmt/UnsatCoreAbductiveStrategy.h"
 
 namespace spexplain {} // namespace spexplain
 
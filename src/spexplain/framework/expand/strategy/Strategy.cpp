@@ -1,6 +1,8 @@
 #include "Strategy.h"
 
 #include <spexplain/common/Macro.h>
+#include <spexplain/common/Profile.h>
+#include <spexplain/framework/Config.h>
 #include <spexplain/framework/explanation/ConjunctExplanation.h>
 #include <spexplain/framework/explanation/Explanation.h>
 #include <spexplain/framework/explanation/IntervalExplanation.h>
@@ -74,6 +76,11 @@ bool Framework::Expand::Strategy::assertExplanationImpl(PartialExplanation const
         return true;
     }
 
+    if (auto * iexpPtr = dynamic_cast<IntervalExplanation const *>(&pexplanation)) {
+        assertIntervalExplanation(*iexpPtr, conf);
+        return true;
+    }
+
     if (auto * cexpPtr = dynamic_cast<ConjunctExplanation const *>(&pexplanation)) {
         assertConjunctExplanation(*cexpPtr, conf);
         return true;
@@ -88,11 +95,6 @@ void Framework::Expand::Strategy::assertConjunctExplanation(ConjunctExplanation
 
 void Framework::Expand::Strategy::assertConjunctExplanation(ConjunctExplanation const & cexplanation,
                                                             AssertExplanationConf const & conf) {
-    if (auto * iexpPtr = dynamic_cast<IntervalExplanation const *>(&cexplanation)) {
-        assertIntervalExplanation(*iexpPtr, conf);
-        return;
-    }
-
     // Does not consider var ordering, unlike interval explanations
     for (auto & pexplanationPtr : cexplanation) {
         if (not pexplanationPtr) { continue; }
@@ -133,11 +135,9 @@ void Framework::Expand::Strategy::assertIntervalExplanationTp(IntervalExplanatio
                 assert(idx != idxToOmit);
             }
 
-            auto * optVarBnd = iexplanation.tryGetVarBound(idx);
-            if (not optVarBnd) { continue; }
+            if (not iexplanation.contains(idx)) { continue; }
 
-            auto & varBnd = *optVarBnd;
-            assertVarBound(varBnd, conf);
+            assertVarBound(iexplanation, idx, conf);
         }
         return;
     }
@@ -149,11 +149,9 @@ void Framework::Expand::Strategy::assertIntervalExplanationTp(IntervalExplanatio
             assert(idx != idxToOmit);
         }
 
-        auto * optVarBnd = iexplanation.tryGetVarBound(idx);
-        if (not optVarBnd) { continue; }
+        if (not iexplanation.contains(idx)) { continue; }
 
-        auto & varBnd = *optVarBnd;
-        assertVarBound(varBnd, conf);
+        assertVarBound(iexplanation, idx, conf);
     }
 }
 
@@ -178,6 +176,33 @@ void Framework::Expand::Strategy::assertVarBound(VarBound const & varBnd, Assert
     assertBound(idx, bnd);
 }
 
+void Framework::Expand::Strategy::assertVarBound(IntervalExplanation const & iexplanation, VarIdx idx) {
+    assertVarBound(iexplanation, idx, AssertExplanationConf{});
+}
+
+// Equivalent to asserting `iexplanation.tryGetVarBound(idx)` but without constructing it
+void Framework::Expand::Strategy::assertVarBound(IntervalExplanation const & iexplanation, VarIdx idx,
+                                                 AssertExplanationConf const & conf) {
+    assert(iexplanation.contains(idx));
+    Float const lo = iexplanation.getLower(idx);
+    Float const hi = iexplanation.getUpper(idx);
+    if (iexplanation.isPoint(idx)) {
+        assertPoint(idx, EqBound{lo}, conf.splitIntervals);
+        return;
+    }
+
+    bool const hasLower = iexplanation.hasLowerBound(idx);
+    bool const hasUpper = iexplanation.hasUpperBound(idx);
+    assert(hasLower or hasUpper);
+    if (hasLower and hasUpper) {
+        assertInnerInterval(idx, LowerBound{lo}, UpperBound{hi}, conf.splitIntervals);
+    } else if (hasLower) {
+        assertLowerBound(idx, LowerBound{lo});
+    } else {
+        assertUpperBound(idx, UpperBound{hi});
+    }
+}
+
 void Framework::Expand::Strategy::assertInterval(VarIdx idx, Interval const & ival) {
     if (ival.isPoint()) {
         assertPoint(idx, ival.getValue());
@@ -297,8 +322,75 @@ void Framework::Expand::Strategy::assertEquality(VarIdx idx, EqBound const & eq)
     getVerifier().addEquality(0, idx, val, storeNamedTerms());
 }
 
+bool Framework::Expand::Strategy::usingAssumptions() const {
+    // The guarded bounds are not named terms
+    return expand.getFramework().getConfig().checkingWithAssumptions() and not storeNamedTerms();
+}
+
+void Framework::Expand::Strategy::assertGuardedIntervalExplanation(IntervalExplanation const & iexplanation) {
+    std::size_t const esize = iexplanation.size();
+    varGuards.assign(esize, invalidGuard);
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (not iexplanation.contains(idx)) { continue; }
+
+        assertGuardedVarBound(iexplanation, idx);
+    }
+}
+
+void Framework::Expand::Strategy::assertGuardedVarBound(IntervalExplanation const & iexplanation, VarIdx idx) {
+    auto & verifier = getVerifier();
+    assert(iexplanation.contains(idx));
+    assert(idx < varGuards.size());
+    Guard & guard = varGuards[idx];
+
+    Float const lo = iexplanation.getLower(idx);
+    Float const hi = iexplanation.getUpper(idx);
+    if (iexplanation.isPoint(idx)) {
+        guard = verifier.addGuardedEquality(0, idx, lo);
+        return;
+    }
+
+    bool const hasLower = iexplanation.hasLowerBound(idx);
+    bool const hasUpper = iexplanation.hasUpperBound(idx);
+    assert(hasLower or hasUpper);
+    if (hasLower and hasUpper) {
+        guard = verifier.addGuardedInterval(0, idx, lo, hi);
+    } else if (hasLower) {
+        guard = verifier.addGuardedLowerBound(0, idx, lo);
+    } else {
+        guard = verifier.addGuardedUpperBound(0, idx, hi);
+    }
+}
+
 bool Framework::Expand::Strategy::checkFormsExplanation() {
-    auto answer = getVerifier().check();
+    Profile::Scope const profileScope{"check"};
+    return formsExplanation(getVerifier().check());
+}
+
+bool Framework::Expand::Strategy::checkFormsExplanationAssumingExcept(IntervalExplanation const & iexplanation,
+                                                                      VarIdx idxToOmit) {
+    std::size_t const esize = iexplanation.size();
+    assert(varGuards.size() == esize);
+
+    std::vector<Guard> guards;
+    guards.reserve(esize);
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (idx == idxToOmit) { continue; }
+        if (not iexplanation.contains(idx)) { continue; }
+
+        assert(varGuards[idx] != invalidGuard);
+        guards.push_back(varGuards[idx]);
+    }
+
+    return checkFormsExplanationAssuming(guards);
+}
+
+bool Framework::Expand::Strategy::checkFormsExplanationAssuming(std::span<Guard const> guards) {
+    Profile::Scope const profileScope{"check"};
+    return formsExplanation(getVerifier().checkAssuming(guards));
+}
+
+bool Framework::Expand::Strategy::formsExplanation(xai::verifiers::Verifier::Answer answer) {
     assert(answer != xai::verifiers::Verifier::Answer::ERROR);
     if (answer == xai::verifiers::Verifier::Answer::UNKNOWN) { throwUnknownResultInternalException(); }
     return (answer == xai::verifiers::Verifier::Answer::UNSAT);
@@ -343,16 +435,13 @@ bool Framework::Expand::Strategy::intersectNonIntervalExplanationImpl(std::uniqu
         return true;
     }
 
-    if (not dynamic_cast<ConjunctExplanation *>(otherExpPtr.get())) {
-        assert(not dynamic_cast<IntervalExplanation *>(otherExpPtr.get()));
-        return false;
-    }
-
     if (auto * optIntExp = dynamic_cast<IntervalExplanation *>(otherExpPtr.get())) {
         // Not both are intervals so we have no other choice
         otherExpPtr = std::move(*optIntExp).toConjunctExplanation(varOrdering.order);
     }
 
+    if (not dynamic_cast<ConjunctExplanation *>(otherExpPtr.get())) { return false; }
+
     explanationPtr.swap(otherExpPtr);
     assert(dynamic_cast<ConjunctExplanation *>(explanationPtr.get()));
     auto & cexp = static_cast<ConjunctExplanation &>(*explanationPtr);
@@ -6,6 +6,11 @@
 #include <spexplain/common/Bound.h>
 #include <spexplain/common/Interval.h>
 
+#include <verifiers/Verifier.h>
+
+#include <span>
+#include <vector>
+
 namespace spexplain {
 class VarBound;
 class PartialExplanation;
@@ -23,9 +28,22 @@ public:
 
     virtual bool requiresSMTSolver() const { return false; }
 
+    // Whether the verifier may assert additional facts implied by the asserted bounds
+    virtual bool allowsBoundPropagation() const { return not storeNamedTerms(); }
+
     virtual void execute(Explanations &, Network::Dataset const &, ExplanationIdx);
 
+    // No. checks within the last execution that were not run by the verifier of Expand
+    virtual std::size_t getExtraChecksCount() const { return 0; }
+
+    // Called for every sample, including those where the strategy is not executed
+    virtual void resetStats() {}
+
 protected:
+    using Guard = xai::verifiers::Verifier::Guard;
+
+    static constexpr Guard invalidGuard = static_cast<Guard>(-1);
+
     struct AssertExplanationConf {
         bool ignoreVarOrder = false;
         bool splitIntervals = false;
@@ -58,6 +76,8 @@ protected:
 
     void assertVarBound(VarBound const &);
     void assertVarBound(VarBound const &, AssertExplanationConf const &);
+    void assertVarBound(IntervalExplanation const &, VarIdx);
+    void assertVarBound(IntervalExplanation const &, VarIdx, AssertExplanationConf const &);
 
     void assertInterval(VarIdx, Interval const &);
     void assertInnerInterval(VarIdx, Interval const &, bool splitIntervals = false);
@@ -74,7 +94,17 @@ protected:
     void assertUpperBound(VarIdx, UpperBound const &);
     void assertEquality(VarIdx, EqBound const &);
 
+    // Whether the explanation is asserted just once as guarded bounds and the checks only assume the guards
+    bool usingAssumptions() const;
+
+    // Guards each variable bound of the explanation separately
+    void assertGuardedIntervalExplanation(IntervalExplanation const &);
+    void assertGuardedVarBound(IntervalExplanation const &, VarIdx);
+
     bool checkFormsExplanation();
+    // Assumes the guards of the variables that are still present in the explanation
+    bool checkFormsExplanationAssumingExcept(IntervalExplanation const &, VarIdx idxToOmit = invalidVarIdx);
+    bool checkFormsExplanationAssuming(std::span<Guard const>);
 
     void intersectExplanation(std::unique_ptr<Explanation> &, std::unique_ptr<Explanation> &&);
     virtual bool intersectExplanationImpl(std::unique_ptr<Explanation> &, std::unique_ptr<Explanation> &);
@@ -85,7 +115,12 @@ protected:
 
     VarOrdering varOrdering;
 
+    // Indexed by the variables
+    std::vector<Guard> varGuards{};
+
 private:
+    static bool formsExplanation(xai::verifiers::Verifier::Answer);
+
     template<bool omitIdx = false>
     void assertIntervalExplanationTp(IntervalExplanation const &, AssertExplanationConf const &,
                                      VarIdx idxToOmit = invalidVarIdx);
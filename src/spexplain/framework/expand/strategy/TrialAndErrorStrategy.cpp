@@ -1,34 +1,71 @@
 #include "TrialAndErrorStrategy.h"
 
-#include <spexplain/framework/Utils.h>
+#include <spexplain/framework/Config.h>
 #include <spexplain/framework/explanation/IntervalExplanation.h>
 #include <spexplain/framework/explanation/VarBound.h>
 
 #include <verifiers/Verifier.h>
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
 
 namespace spexplain {
+void Framework::Expand::TrialAndErrorStrategy::executeInit(Explanations & explanations, Network::Dataset const & data,
+                                                           ExplanationIdx idx) {
+    Strategy::executeInit(explanations, data, idx);
+
+    if (not config.parallel) { return; }
+
+    // The previous execution may have been interrupted by a timeout
+    if (probesAsserted) { resetProbes(); }
+    initProbes(data.getComputedOutput(idx).classification);
+}
+
+void Framework::Expand::TrialAndErrorStrategy::executeFinish(Explanations & explanations,
+                                                             Network::Dataset const & data, ExplanationIdx idx) {
+    if (config.parallel) { resetProbes(); }
+
+    Strategy::executeFinish(explanations, data, idx);
+}
+
 void Framework::Expand::TrialAndErrorStrategy::executeBody(Explanations & explanations, Network::Dataset const &,
                                                            ExplanationIdx idx) {
     auto & explanation = getExplanation(explanations, idx);
     assert(dynamic_cast<IntervalExplanation *>(&explanation));
     auto & iexplanation = static_cast<IntervalExplanation &>(explanation);
 
+    if (config.parallel) {
+        executeBodyParallel(iexplanation);
+    } else {
+        executeBodySequential(iexplanation);
+    }
+}
+
+void Framework::Expand::TrialAndErrorStrategy::executeBodySequential(IntervalExplanation & iexplanation) {
     auto & fw = expand.getFramework();
     auto & verifier = getVerifier();
     auto const maxAttempts = config.maxAttempts;
     assert(maxAttempts > 0);
 
+    bool const assuming = usingAssumptions();
+    if (assuming) { assertGuardedIntervalExplanation(iexplanation); }
+
+    // Only the relaxed interval is asserted within the attempts, the rest of the explanation is assumed
+    auto checkAttempt = [&](VarIdx idxToRelax) {
+        if (assuming) { return checkFormsExplanationAssumingExcept(iexplanation, idxToRelax); }
+        return checkFormsExplanation();
+    };
+
     for (VarIdx idxToRelax : varOrdering.order) {
-        auto * optVarBndToRelax = iexplanation.tryGetVarBound(idxToRelax);
-        if (not optVarBndToRelax) { continue; }
+        if (not iexplanation.contains(idxToRelax)) { continue; }
 
-        verifier.push();
-        assertIntervalExplanationExcept(iexplanation, idxToRelax, {.ignoreVarOrder = true});
+        if (not assuming) {
+            verifier.push();
+            assertIntervalExplanationExcept(iexplanation, idxToRelax, {.ignoreVarOrder = true});
+        }
 
-        auto & varBndToRelax = *optVarBndToRelax;
-        Interval origInterval = varBndToRelax.toInterval();
+        Interval origInterval = iexplanation.getInterval(idxToRelax);
         Interval const & domainInterval = fw.getDomainInterval(idxToRelax);
         auto [oLo, oHi] = origInterval.getBounds();
         auto const [dLo, dHi] = domainInterval.getBounds();
@@ -42,7 +79,7 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(Explanations & explan
                 Float const lo = relaxedLowerIval.getLower();
                 assert(lo < oLo);
                 assertInterval(idxToRelax, relaxedLowerIval);
-                bool const ok = checkFormsExplanation();
+                bool const ok = checkAttempt(idxToRelax);
                 if (ok) {
                     oLo = lo;
                     origInterval.setLower(oLo);
@@ -60,7 +97,7 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(Explanations & explan
                 Float const hi = relaxedUpperIval.getUpper();
                 assert(hi > oHi);
                 assertInterval(idxToRelax, relaxedUpperIval);
-                bool const ok = checkFormsExplanation();
+                bool const ok = checkAttempt(idxToRelax);
                 if (ok) {
                     oHi = hi;
                     origInterval.setUpper(oHi);
@@ -71,10 +108,173 @@ void Framework::Expand::TrialAndErrorStrategy::executeBody(Explanations & explan
             verifier.pop();
         }
 
-        verifier.pop();
+        if (not assuming) { verifier.pop(); }
+
+        iexplanation.setInterval(idxToRelax, origInterval);
+
+        // The previous guard of the variable is just no longer assumed
+        if (assuming and iexplanation.contains(idxToRelax)) { assertGuardedVarBound(iexplanation, idxToRelax); }
+    }
+}
+
+// Yields the same explanations as the sequential version:
+// the widest successful attempt is the first successful one of the sequential attempts
+void Framework::Expand::TrialAndErrorStrategy::executeBodyParallel(IntervalExplanation & iexplanation) {
+    auto & fw = expand.getFramework();
+
+    for (VarIdx idxToRelax : varOrdering.order) {
+        if (not iexplanation.contains(idxToRelax)) { continue; }
+
+        Interval origInterval = iexplanation.getInterval(idxToRelax);
+        Interval const & domainInterval = fw.getDomainInterval(idxToRelax);
+        auto [oLo, oHi] = origInterval.getBounds();
+        auto const [dLo, dHi] = domainInterval.getBounds();
+        assert(dLo <= oLo and oHi <= dHi);
+        assert(dLo < oLo or oHi < dHi);
+
+        std::vector<Float> const lowerLadder = (oLo != dLo) ? makeLadder(dLo, oLo) : std::vector<Float>{};
+        std::vector<Float> const upperLadder = (oHi != dHi) ? makeLadder(dHi, oHi) : std::vector<Float>{};
+        std::size_t const nLower = lowerLadder.size();
+        std::size_t const nUpper = upperLadder.size();
+
+        // The upper bound is tried speculatively with the original lower bound
+        std::vector<Interval> intervals;
+        intervals.reserve(nLower + nUpper);
+        for (Float lo : lowerLadder) {
+            intervals.emplace_back(lo, oHi);
+        }
+        for (Float hi : upperLadder) {
+            intervals.emplace_back(oLo, hi);
+        }
+        std::vector<bool> const oks = checkRelaxedIntervals(iexplanation, idxToRelax, intervals);
+        assert(oks.size() == nLower + nUpper);
+
+        bool lowerRelaxed = false;
+        for (std::size_t i = 0; i < nLower; ++i) {
+            if (not oks[i]) { continue; }
+            oLo = lowerLadder[i];
+            origInterval.setLower(oLo);
+            lowerRelaxed = true;
+            break;
+        }
+
+        std::vector<Float> upperCandidates;
+        for (std::size_t i = 0; i < nUpper; ++i) {
+            if (oks[nLower + i]) { upperCandidates.push_back(upperLadder[i]); }
+        }
+
+        // Relaxing the lower bound can only invalidate the successful attempts of the upper bound, not the other way
+        std::vector<bool> upperOks(upperCandidates.size(), true);
+        if (lowerRelaxed and not upperCandidates.empty()) {
+            intervals.clear();
+            for (Float hi : upperCandidates) {
+                intervals.emplace_back(oLo, hi);
+            }
+            upperOks = checkRelaxedIntervals(iexplanation, idxToRelax, intervals);
+        }
+
+        for (std::size_t i = 0; i < upperCandidates.size(); ++i) {
+            if (not upperOks[i]) { continue; }
+            oHi = upperCandidates[i];
+            origInterval.setUpper(oHi);
+            break;
+        }
+
+        iexplanation.setInterval(idxToRelax, origInterval);
+    }
+}
+
+std::vector<Float> Framework::Expand::TrialAndErrorStrategy::makeLadder(Float domainBound, Float origBound) const {
+    auto const maxAttempts = config.maxAttempts;
+    assert(maxAttempts > 0);
+
+    std::vector<Float> ladder;
+    ladder.reserve(maxAttempts);
+    Float bound = domainBound;
+    for (int i = 0; i < maxAttempts; ++i) {
+        assert(bound != origBound);
+        ladder.push_back(bound);
+        bound = (bound + origBound) / 2;
+    }
+
+    return ladder;
+}
+
+void Framework::Expand::TrialAndErrorStrategy::initProbes(Network::Classification const & cls) {
+    assert(not probesAsserted);
+
+    auto const & conf = expand.getFramework().getConfig();
+
+    // Enough for all attempts of both bounds at once
+    std::size_t const nProbes = 2 * config.maxAttempts;
+    while (probes.size() < nProbes) {
+        auto expandPtr = expand.makeVerifierWorker();
+        expandPtr->initVerifier();
+        auto strategyPtr = std::make_unique<TrialAndErrorStrategy>(*expandPtr);
+        probes.push_back({std::move(expandPtr), std::move(strategyPtr)});
+    }
+    // The threads persist across the features and samples
+    if (not threadPoolPtr) { threadPoolPtr = std::make_unique<ThreadPool>(nProbes); }
+
+    for (auto & probe : probes) {
+        auto & probeExpand = *probe.expandPtr;
+        if (conf.timeLimitPerExplanationIsSet()) {
+            probeExpand.verifierPtr->setTimeLimit(conf.getTimeLimitPerExplanation());
+        }
+        probeExpand.assertModel();
+        probeExpand.assertClassification(cls);
+    }
+
+    probesAsserted = true;
+}
+
+void Framework::Expand::TrialAndErrorStrategy::resetProbes() {
+    assert(probesAsserted);
 
-        auto varBndPtr = intervalToOptVarBound(fw, idxToRelax, std::move(origInterval));
-        iexplanation[idxToRelax] = std::move(varBndPtr);
+    for (auto & probe : probes) {
+        auto & probeExpand = *probe.expandPtr;
+        probeExpand.resetClassification();
+        probeExpand.resetModel();
     }
+
+    probesAsserted = false;
+}
+
+std::vector<bool> Framework::Expand::TrialAndErrorStrategy::checkRelaxedIntervals(
+    IntervalExplanation const & iexplanation, VarIdx idx, std::vector<Interval> const & intervals) {
+    std::size_t const size = intervals.size();
+    assert(size <= probes.size());
+
+    // Not std::vector<bool> which is not safe to be written concurrently
+    std::vector<char> oks(size);
+    std::vector<std::exception_ptr> exceptions(size);
+    threadPoolPtr->run(size, [&](std::size_t i) {
+        try {
+            oks[i] = probes[i].strategyPtr->checkRelaxedInterval(iexplanation, idx, intervals[i]);
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    });
+
+    probeChecksCount += size;
+
+    for (auto & exceptionPtr : exceptions) {
+        if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+    }
+
+    return {oks.begin(), oks.end()};
+}
+
+bool Framework::Expand::TrialAndErrorStrategy::checkRelaxedInterval(IntervalExplanation const & iexplanation,
+                                                                    VarIdx idx, Interval const & ival) {
+    auto & verifier = getVerifier();
+
+    verifier.push();
+    assertIntervalExplanationExcept(iexplanation, idx, {.ignoreVarOrder = true});
+    assertInterval(idx, ival);
+    bool const ok = checkFormsExplanation();
+    verifier.pop();
+
+    return ok;
 }
 } // namespace spexplain
@@ -3,11 +3,18 @@
 
 #include "Strategy.h"
 
+#include <spexplain/common/ThreadPool.h>
+
+#include <memory>
+#include <vector>
+
 namespace spexplain {
 class Framework::Expand::TrialAndErrorStrategy : public Strategy {
 public:
     struct Config {
         int maxAttempts = 4;
+        // Run all attempts of a feature at once, each with its own verifier
+        bool parallel = false;
     };
 
     using Strategy::Strategy;
@@ -17,10 +24,39 @@ public:
 
     static char const * name() { return "trial"; }
 
+    std::size_t getExtraChecksCount() const override { return probeChecksCount; }
+
+    void resetStats() override { probeChecksCount = 0; }
+
 protected:
+    struct Probe {
+        std::unique_ptr<Expand> expandPtr;
+        std::unique_ptr<TrialAndErrorStrategy> strategyPtr;
+    };
+
+    void executeInit(Explanations &, Network::Dataset const &, ExplanationIdx) override;
     void executeBody(Explanations &, Network::Dataset const &, ExplanationIdx) override;
+    void executeFinish(Explanations &, Network::Dataset const &, ExplanationIdx) override;
+
+    void executeBodySequential(IntervalExplanation &);
+    void executeBodyParallel(IntervalExplanation &);
+
+    // Candidates of the relaxed bound, from the widest to the original one (exclusive)
+    std::vector<Float> makeLadder(Float domainBound, Float origBound) const;
+
+    void initProbes(Network::Classification const &);
+    void resetProbes();
+
+    // Checks each interval of the feature with a separate probe in parallel
+    std::vector<bool> checkRelaxedIntervals(IntervalExplanation const &, VarIdx, std::vector<Interval> const &);
+    bool checkRelaxedInterval(IntervalExplanation const &, VarIdx, Interval const &);
 
     Config config{};
+
+    std::vector<Probe> probes{};
+    std::unique_ptr<ThreadPool> threadPoolPtr{};
+    bool probesAsserted{false};
+    std::size_t probeChecksCount{};
 };
 } // namespace spexplain
 
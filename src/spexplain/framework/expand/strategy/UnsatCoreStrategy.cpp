@@ -40,20 +40,18 @@ void Framework::Expand::UnsatCoreStrategy::executeBody(Explanations & explanatio
     assert(storeNamedTerms());
 
     auto & explanation = getExplanation(explanations, idx);
-    if (not dynamic_cast<ConjunctExplanation *>(&explanation)) { return; }
-
-    auto & cexplanation = static_cast<ConjunctExplanation &>(explanation);
-
-    if (auto * iexpPtr = dynamic_cast<IntervalExplanation *>(&cexplanation)) {
+    if (auto * iexpPtr = dynamic_cast<IntervalExplanation *>(&explanation)) {
         executeBody(*iexpPtr);
         return;
     }
 
+    if (not dynamic_cast<ConjunctExplanation *>(&explanation)) { return; }
+
+    auto & cexplanation = static_cast<ConjunctExplanation &>(explanation);
     executeBody(cexplanation);
 }
 
 void Framework::Expand::UnsatCoreStrategy::executeBody(ConjunctExplanation & cexplanation) {
-    assert(not dynamic_cast<IntervalExplanation *>(&cexplanation));
     //+ not supported for general conjunctions
     assert(not config.splitIntervals);
 
@@ -115,26 +113,19 @@ void Framework::Expand::UnsatCoreStrategy::executeBody(IntervalExplanation & iex
     IntervalExplanation newExplanation{fw};
 
     for (VarIdx idx : unsatCore.lowerBounds) {
-        auto * optVarBnd = iexplanation.tryGetVarBound(idx);
-        assert(optVarBnd);
-        auto & varBnd = *optVarBnd;
-        Bound const & bnd = varBnd.isInterval() ? varBnd.getIntervalLower() : varBnd.getBound();
-        newExplanation.insertBound(idx, LowerBound{bnd});
+        assert(iexplanation.contains(idx));
+        newExplanation.insertBound(idx, LowerBound{iexplanation.getLower(idx)});
     }
     for (VarIdx idx : unsatCore.upperBounds) {
-        auto * optVarBnd = iexplanation.tryGetVarBound(idx);
-        assert(optVarBnd);
-        auto & varBnd = *optVarBnd;
-        Bound const & bnd = varBnd.isInterval() ? varBnd.getIntervalUpper() : varBnd.getBound();
-        newExplanation.insertBound(idx, UpperBound{bnd});
+        assert(iexplanation.contains(idx));
+        newExplanation.insertBound(idx, UpperBound{iexplanation.getUpper(idx)});
     }
 
     for (auto & indices : {unsatCore.equalities, unsatCore.intervals}) {
         for (VarIdx idx : indices) {
-            auto * optVarBnd = iexplanation.tryGetVarBound(idx);
-            assert(optVarBnd);
-            assert(optVarBnd->isPoint() or optVarBnd->isInterval());
-            newExplanation.insertVarBound(std::move(*optVarBnd));
+            assert(iexplanation.contains(idx));
+            assert(not newExplanation.contains(idx));
+            newExplanation.setInterval(idx, iexplanation.getInterval(idx));
         }
     }
 
@@ -4,6 +4,7 @@
 #include <spexplain/framework/explanation/IntervalExplanation.h>
 #include <spexplain/framework/explanation/opensmt/FormulaExplanation.h>
 
+#include <spexplain/common/Profile.h>
 #include <spexplain/common/Utils.h>
 
 #include <verifiers/opensmt/OpenSMTVerifier.h>
@@ -120,7 +121,11 @@ void InterpolationStrategy::executeBody(Explanations & explanations, Network::Da
 
     ::opensmt::vec<Formula> itps;
     auto interpolationContext = solver.getInterpolationContext();
-    bool const success = interpolationContext->getSingleInterpolant(itps, part);
+    bool success{};
+    {
+        Profile::Scope const profileScope{"getSingleInterpolant"};
+        success = interpolationContext->getSingleInterpolant(itps, part);
+    }
     if (not success) { throwUnknownResultInternalException(); }
     assert(itps.size() == 1);
     Formula itp = itps[0];
@@ -144,7 +149,7 @@ void InterpolationStrategy::executeBody(Explanations & explanations, Network::Da
 #endif
 
     if (not filteringVars and not itpIsConj) {
-        assignNew<FormulaExplanation>(explanationPtr, fw, itp);
+        assignNew<FormulaExplanation>(explanationPtr, fw, verifier, itp);
         return;
     }
 
@@ -154,7 +159,7 @@ void InterpolationStrategy::executeBody(Explanations & explanations, Network::Da
         assert(not logic.isAnd(phi));
         assert(logic.isOr(phi) or isLit(phi) or (logic.isNot(phi) and logic.isAnd(logic.getPterm(phi)[0])));
         if (logic.isTrue(phi)) { return; }
-        auto phiexplanationPtr = std::make_unique<FormulaExplanation>(fw, phi);
+        auto phiexplanationPtr = std::make_unique<FormulaExplanation>(fw, verifier, phi);
         newConjExplanation.insertExplanation(std::move(phiexplanationPtr));
     };
 
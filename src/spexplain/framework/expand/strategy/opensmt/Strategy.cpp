@@ -19,6 +19,19 @@ xai::verifiers::OpenSMTVerifier & Strategy::getVerifier() {
     return const_cast<xai::verifiers::OpenSMTVerifier &>(std::as_const(*this).getVerifier());
 }
 
+void Strategy::produceUnsatCores(bool minimal) {
+    auto & verifier = getVerifier();
+    auto & solver = verifier.getSolver();
+    auto & solverConf = solver.getConfig();
+
+    using ::opensmt::SMTConfig;
+    using ::opensmt::SMTOption;
+
+    char const * msg = "ok";
+    solverConf.setOption(SMTConfig::o_produce_unsat_cores, SMTOption(true), msg);
+    solverConf.setOption(SMTConfig::o_minimal_unsat_cores, SMTOption(minimal), msg);
+}
+
 bool Strategy::assertExplanationImpl(PartialExplanation const & pexplanation, AssertExplanationConf const & conf) {
     if (Framework::Expand::Strategy::assertExplanationImpl(pexplanation, conf)) { return true; }
 
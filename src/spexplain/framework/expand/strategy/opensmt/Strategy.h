@@ -21,10 +21,15 @@ public:
 
     bool requiresSMTSolver() const override { return true; }
 
+    // The interpolants or unsat cores would depend on the additional facts
+    bool allowsBoundPropagation() const override { return false; }
+
 protected:
     xai::verifiers::OpenSMTVerifier const & getVerifier() const;
     xai::verifiers::OpenSMTVerifier & getVerifier();
 
+    void produceUnsatCores(bool minimal = false);
+
     bool assertExplanationImpl(PartialExplanation const &, AssertExplanationConf const &) override;
 
     void assertFormulaExplanation(FormulaExplanation const &);
@@ -0,0 +1,84 @@
+#include "UnsatCoreAbductiveStrategy.h"
+
+#include <spexplain/framework/explanation/IntervalExplanation.h>
+#include <spexplain/framework/explanation/VarBound.h>
+
+#include <verifiers/opensmt/OpenSMTVerifier.h>
+
+#include <cassert>
+
+namespace spexplain::expand::opensmt {
+void UnsatCoreAbductiveStrategy::executeInit(Explanations & explanations, Network::Dataset const & data,
+                                             ExplanationIdx idx) {
+    Strategy::executeInit(explanations, data, idx);
+
+    produceUnsatCores(config.minimal);
+}
+
+void UnsatCoreAbductiveStrategy::executeBody(Explanations & explanations, Network::Dataset const &,
+                                             ExplanationIdx idx) {
+    assert(storeNamedTerms());
+
+    auto & explanation = getExplanation(explanations, idx);
+    assert(dynamic_cast<IntervalExplanation *>(&explanation));
+    auto & iexplanation = static_cast<IntervalExplanation &>(explanation);
+
+    inUnsatCore.assign(iexplanation.size(), false);
+
+    // The features that are irrelevant already for the whole explanation are dropped right away
+    [[maybe_unused]] bool const ok = checkAndEraseExcept(iexplanation);
+    assert(ok);
+
+    // The explanation only shrinks, so the features that could not be erased remain necessary
+    for (VarIdx idxToOmit : varOrdering.order) {
+        if (not iexplanation.contains(idxToOmit)) { continue; }
+
+        // It is no longer explanation after the removal -> we cannot remove it
+        if (not checkAndEraseExcept(iexplanation, idxToOmit)) { continue; }
+
+        assert(not iexplanation.contains(idxToOmit));
+    }
+}
+
+bool UnsatCoreAbductiveStrategy::checkAndEraseExcept(IntervalExplanation & iexplanation, VarIdx idxToOmit) {
+    auto & verifier = getVerifier();
+
+    verifier.push();
+    // One named term per variable, which is required by the unsat cores
+    if (idxToOmit == invalidVarIdx) {
+        assertIntervalExplanation(iexplanation, {.ignoreVarOrder = true, .splitIntervals = false});
+    } else {
+        assertIntervalExplanationExcept(iexplanation, idxToOmit, {.ignoreVarOrder = true, .splitIntervals = false});
+    }
+    bool const ok = checkFormsExplanation();
+    if (ok) { eraseVarBoundsNotIn(iexplanation, verifier.getUnsatCore()); }
+    verifier.pop();
+    // The named terms are not scoped
+    verifier.resetSampleQuery();
+
+    return ok;
+}
+
+void UnsatCoreAbductiveStrategy::eraseVarBoundsNotIn(IntervalExplanation & iexplanation,
+                                                     xai::verifiers::UnsatCore const & unsatCore) {
+    std::size_t const esize = iexplanation.size();
+    assert(inUnsatCore.size() == esize);
+
+    for (auto & indices : {unsatCore.lowerBounds, unsatCore.upperBounds, unsatCore.equalities, unsatCore.intervals}) {
+        for (VarIdx idx : indices) {
+            assert(idx < esize);
+            inUnsatCore[idx] = true;
+        }
+    }
+
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (inUnsatCore[idx]) {
+            inUnsatCore[idx] = false;
+            continue;
+        }
+        if (not iexplanation.contains(idx)) { continue; }
+
+        iexplanation.eraseVarBound(idx);
+    }
+}
+} // namespace spexplain::expand::opensmt
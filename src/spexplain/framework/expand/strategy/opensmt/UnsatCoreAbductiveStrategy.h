@@ -0,0 +1,49 @@
+#ifndef SPEXPLAIN_EXPAND_OSMTUCOREABDUCTIVESTRATEGY_H
+#define SPEXPLAIN_EXPAND_OSMTUCOREABDUCTIVESTRATEGY_H
+
+#include "Strategy.h"
+
+#include <vector>
+
+namespace xai::verifiers {
+struct UnsatCore;
+}
+
+namespace spexplain::expand::opensmt {
+// Yields a subset-minimal explanation as the abductive strategy, but whenever a check succeeds,
+// it also drops all the features that are not in the unsat core
+class UnsatCoreAbductiveStrategy : public Strategy {
+public:
+    struct Config {
+        bool minimal = false;
+    };
+
+    using Strategy::Strategy;
+    UnsatCoreAbductiveStrategy(Framework::Expand & exp, Config const & conf,
+                               Framework::Expand::VarOrdering order = {})
+        : Framework::Expand::Strategy{exp, std::move(order)},
+          Strategy{exp}, // necessary but actually ignored by the compiler
+          config{conf} {}
+
+    static char const * name() { return "abductive-ucore"; }
+
+protected:
+    bool storeNamedTerms() const override { return true; }
+
+    void executeInit(Explanations &, Network::Dataset const &, ExplanationIdx) override;
+    void executeBody(Explanations &, Network::Dataset const &, ExplanationIdx) override;
+
+    // Returns true if the explanation without the variable is still an explanation, and if so,
+    // also erases the variables of the explanation that are not in the unsat core
+    bool checkAndEraseExcept(IntervalExplanation &, VarIdx idxToOmit = invalidVarIdx);
+
+    void eraseVarBoundsNotIn(IntervalExplanation &, xai::verifiers::UnsatCore const &);
+
+    Config config{};
+
+    // Whether the variable is within the last unsat core
+    std::vector<bool> inUnsatCore{};
+};
+} // namespace spexplain::expand::opensmt
+
+#endif // SPEXPLAIN_EXPAND_OSMTUCOREABDUCTIVESTRATEGY_H
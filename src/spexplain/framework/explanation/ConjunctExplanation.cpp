@@ -1,5 +1,8 @@
 #include "ConjunctExplanation.h"
 
+#include "IntervalExplanation.h"
+
+#include <spexplain/common/Macro.h>
 #include <spexplain/common/Print.h>
 
 #include <algorithm>
@@ -93,6 +96,17 @@ void ConjunctExplanation::intersect(std::unique_ptr<Explanation> && explanationP
         return;
     }
 
+    if (auto optIntExp = dynamic_cast<IntervalExplanation *>(explanationPtr.get())) {
+        auto & iexplanation = *optIntExp;
+        std::size_t const size_ = iexplanation.size();
+        for (VarIdx idx = 0; idx < size_; ++idx) {
+            auto optVarBnd = iexplanation.tryGetVarBound(idx);
+            if (not optVarBnd) { continue; }
+            insertExplanation(MAKE_UNIQUE(*std::move(optVarBnd)));
+        }
+        return;
+    }
+
     insertExplanation(std::move(explanationPtr));
 }
 
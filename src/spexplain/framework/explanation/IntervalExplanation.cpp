@@ -1,33 +1,105 @@
 #include "IntervalExplanation.h"
 
+#include "ConjunctExplanation.h"
+
 #include "../Config.h"
 
 #include <spexplain/common/Macro.h>
 #include <spexplain/common/Print.h>
 
 #include <algorithm>
+#include <bit>
 #include <ostream>
 
 namespace spexplain {
-IntervalExplanation::IntervalExplanation(Framework const & fw) : ConjunctExplanation{fw, fw.varSize()} {
+IntervalExplanation::IntervalExplanation(Framework const & fw) : Explanation{fw} {
+    std::size_t const size_ = fw.varSize();
+    lowers.reserve(size_);
+    uppers.reserve(size_);
+    for (VarIdx idx = 0; idx < size_; ++idx) {
+        auto const [dLo, dHi] = fw.getDomainInterval(idx).getBounds();
+        lowers.push_back(dLo);
+        uppers.push_back(dHi);
+    }
+
+    std::size_t const maskSize = (size_ + maskWordBits - 1) / maskWordBits;
+    presenceMask.assign(maskSize, 0);
+    pointMask.assign(maskSize, 0);
+
     assert(size() == frameworkPtr->varSize());
 }
 
+std::size_t IntervalExplanation::countBits(Mask const & mask) {
+    std::size_t cnt{};
+    for (std::uint64_t word : mask) {
+        cnt += std::popcount(word);
+    }
+    return cnt;
+}
+
+bool IntervalExplanation::hasLowerBound(VarIdx idx) const {
+    if (not contains(idx) or isPoint(idx)) { return false; }
+    return getLower(idx) != frameworkPtr->getDomainInterval(idx).getLower();
+}
+
+bool IntervalExplanation::hasUpperBound(VarIdx idx) const {
+    if (not contains(idx) or isPoint(idx)) { return false; }
+    return getUpper(idx) != frameworkPtr->getDomainInterval(idx).getUpper();
+}
+
+std::optional<VarBound> IntervalExplanation::tryGetVarBound(VarIdx idx) const {
+    if (not contains(idx)) { return std::nullopt; }
+
+    auto & fw = *frameworkPtr;
+    if (isPoint(idx)) { return VarBound{fw, idx, getLower(idx)}; }
+
+    // The bounds that correspond to the domain are dropped by the constructor
+    return VarBound{fw, idx, LowerBound{getLower(idx)}, UpperBound{getUpper(idx)}};
+}
+
 std::size_t IntervalExplanation::varSize() const {
-    return validSize();
+    return countBits(presenceMask);
+}
+
+std::size_t IntervalExplanation::termSize() const {
+    std::size_t size_{};
+    std::size_t const esize = size();
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (not contains(idx)) { continue; }
+        bool const isInterval = hasLowerBound(idx) and hasUpperBound(idx);
+        size_ += isInterval ? 2 : 1;
+    }
+
+    return size_;
 }
 
-void IntervalExplanation::insertExplanation(std::unique_ptr<PartialExplanation>) {
-    // Not compatible
-    assert(false);
+void IntervalExplanation::clear() {
+    Explanation::clear();
+
+    std::size_t const size_ = size();
+    for (VarIdx idx = 0; idx < size_; ++idx) {
+        setFree(idx);
+    }
+}
+
+void IntervalExplanation::swap(IntervalExplanation & rhs) {
+    Explanation::swap(rhs);
+
+    lowers.swap(rhs.lowers);
+    uppers.swap(rhs.uppers);
+    presenceMask.swap(rhs.presenceMask);
+    pointMask.swap(rhs.pointMask);
 }
 
-void IntervalExplanation::insertVarBound(VarBound varBnd) {
-    VarIdx idx = varBnd.getVarIdx();
+void IntervalExplanation::insertVarBound(VarBound const & varBnd) {
+    VarIdx const idx = varBnd.getVarIdx();
     assert(not contains(idx));
-    auto & pexplanationPtr = operator[](idx);
-    auto varBndPtr = MAKE_UNIQUE(std::move(varBnd));
-    pexplanationPtr = std::move(varBndPtr);
+
+    auto const [lo, hi] = varBnd.toInterval().getBounds();
+    lowers[idx] = lo;
+    uppers[idx] = hi;
+    setBit(presenceMask, idx);
+    if (varBnd.isPoint()) { setBit(pointMask, idx); }
 }
 
 void IntervalExplanation::insertBound(VarIdx idx, Bound bnd) {
@@ -44,86 +116,96 @@ void IntervalExplanation::insertBound(VarIdx idx, Bound bnd) {
     assert(not valIsUpper or bnd.isEq());
 #endif
 
-    auto * optVarBnd = tryGetVarBound(idx);
-    if (not optVarBnd) {
+    if (not contains(idx)) {
         insertVarBound(VarBound{*frameworkPtr, idx, std::move(bnd)});
         return;
     }
 
-    VarBound & varBnd = *optVarBnd;
-    assert(not varBnd.isInterval());
-    assert(not varBnd.isPoint());
+    assert(not isPoint(idx));
     assert(not bnd.isEq());
-    assert(bnd.isLower() xor varBnd.getBound().isLower());
-    assert(bnd.isUpper() xor varBnd.getBound().isUpper());
-    varBnd.insertBound(std::move(bnd));
-}
+    if (bnd.isLower()) {
+        assert(not hasLowerBound(idx));
+        assert(bnd.getValue() <= getUpper(idx));
+        lowers[idx] = bnd.getValue();
+    } else {
+        assert(bnd.isUpper());
+        assert(not hasUpperBound(idx));
+        assert(bnd.getValue() >= getLower(idx));
+        uppers[idx] = bnd.getValue();
+    }
 
-void IntervalExplanation::condense() {
-    // The sparseness needs to be kept here ...
-    assert(false);
+    if (lowers[idx] == uppers[idx]) { setBit(pointMask, idx); }
 }
 
-void IntervalExplanation::intersect(std::unique_ptr<Explanation> && explanationPtr) {
-    if (auto optIntExp = dynamic_cast<IntervalExplanation *>(explanationPtr.get())) {
-        intersect(std::move(*optIntExp));
+void IntervalExplanation::setInterval(VarIdx idx, Interval const & ival) {
+    auto const [lo, hi] = ival.getBounds();
+    auto const [dLo, dHi] = frameworkPtr->getDomainInterval(idx).getBounds();
+    assert(lo >= dLo and hi <= dHi);
+    if (lo == dLo and hi == dHi) {
+        setFree(idx);
         return;
     }
 
-    ConjunctExplanation::intersect(std::move(explanationPtr));
+    lowers[idx] = lo;
+    uppers[idx] = hi;
+    setBit(presenceMask, idx);
+    if (lo == hi) {
+        setBit(pointMask, idx);
+    } else {
+        resetBit(pointMask, idx);
+    }
+}
+
+bool IntervalExplanation::eraseVarBound(VarIdx idx) {
+    if (not contains(idx)) { return false; }
+    setFree(idx);
+    return true;
 }
 
-void IntervalExplanation::intersect(ConjunctExplanation &&) {
-    // Would result in non-IntervalExplanation
-    assert(false);
+void IntervalExplanation::setFree(VarIdx idx) {
+    auto const [dLo, dHi] = frameworkPtr->getDomainInterval(idx).getBounds();
+    lowers[idx] = dLo;
+    uppers[idx] = dHi;
+    resetBit(presenceMask, idx);
+    resetBit(pointMask, idx);
 }
 
 void IntervalExplanation::intersect(IntervalExplanation && rhs) {
     assert(size() == rhs.size());
 
+    // The free sides hold the bounds of the domain, hence they do not affect the intersection
     std::size_t const size_ = size();
     for (VarIdx idx = 0; idx < size_; ++idx) {
-        auto & varBndPtr2 = rhs[idx];
-        if (not varBndPtr2) { continue; }
-
-        auto & varBndPtr = operator[](idx);
-        if (not varBndPtr) {
-            varBndPtr = std::move(varBndPtr2);
-            continue;
-        }
-
-        assert(varBndPtr and varBndPtr2);
-        auto & varBnd = *castToVarBound(varBndPtr.get());
-        auto & varBnd2 = *castToVarBound(varBndPtr2.get());
-        // It assumes that they have at least some overlap
-        varBnd.intersect(std::move(varBnd2));
+        if (not rhs.contains(idx)) { continue; }
+
+        Float const lo = std::max(lowers[idx], rhs.lowers[idx]);
+        Float const hi = std::min(uppers[idx], rhs.uppers[idx]);
+        assert(lo <= hi);
+        lowers[idx] = lo;
+        uppers[idx] = hi;
+        setBit(presenceMask, idx);
+        if (lo == hi) { setBit(pointMask, idx); }
     }
 }
 
 std::unique_ptr<ConjunctExplanation>
 IntervalExplanation::toConjunctExplanation(std::vector<VarIdx> const & varOrder) && {
-    [[maybe_unused]] auto const varSize_ = varSize();
-
     ConjunctExplanation cexplanation{*frameworkPtr};
 
     for (VarIdx idx : varOrder) {
-        auto & varBndPtr = operator[](idx);
-        if (not varBndPtr) { continue; }
-        cexplanation.insertExplanation(std::move(varBndPtr));
+        auto optVarBnd = tryGetVarBound(idx);
+        if (not optVarBnd) { continue; }
+        cexplanation.insertExplanation(MAKE_UNIQUE(*std::move(optVarBnd)));
     }
 
-    assert(cexplanation.size() == varSize_);
+    assert(cexplanation.size() == varSize());
     assert(not cexplanation.isSparse());
 
     return MAKE_UNIQUE(std::move(cexplanation));
 }
 
 std::size_t IntervalExplanation::computeFixedCount() const {
-    return std::ranges::count_if(*this, [](auto const & expPtr) {
-        if (not expPtr) { return false; }
-        auto & varBnd = *castToVarBound(expPtr.get());
-        return varBnd.isPoint();
-    });
+    return countBits(pointMask);
 }
 
 Float IntervalExplanation::getRelativeVolume() const {
@@ -137,10 +219,10 @@ Float IntervalExplanation::getRelativeVolumeSkipFixed() const {
 template<bool skipFixed>
 Float IntervalExplanation::computeRelativeVolumeTp() const {
     Float relVolume = 1;
-    for (auto const & expPtr : *this) {
-        if (not expPtr) { continue; }
-        auto & varBnd = *castToVarBound(expPtr.get());
-        Float const size = varBnd.size();
+    std::size_t const size_ = size();
+    for (VarIdx idx = 0; idx < size_; ++idx) {
+        if (not contains(idx)) { continue; }
+        Float const size = uppers[idx] - lowers[idx];
         assert(size >= 0);
         if (size == 0) {
             if constexpr (skipFixed) {
@@ -150,7 +232,6 @@ Float IntervalExplanation::computeRelativeVolumeTp() const {
             }
         }
 
-        auto const & idx = varBnd.getVarIdx();
         Float const domainSize = frameworkPtr->getDomainInterval(idx).size();
         assert(domainSize > 0);
         assert(size < domainSize);
@@ -199,6 +280,49 @@ void IntervalExplanation::print(std::ostream & os, PrintConfig const & conf) con
     }
 }
 
+void IntervalExplanation::printSmtLib2(std::ostream & os, PrintConfig const & conf) const {
+    os << "(and";
+    std::size_t const size_ = size();
+    for (VarIdx idx = 0; idx < size_; ++idx) {
+        if (not contains(idx)) { continue; }
+        os << conf.delim;
+        printElemSmtLib2(os, idx);
+    }
+    os << ')';
+}
+
+void IntervalExplanation::printElemSmtLib2(std::ostream & os, VarIdx idx) const {
+    assert(contains(idx));
+
+    if (isPoint(idx)) {
+        printSmtLib2Bound(os, idx, EqBound{getLower(idx)});
+        return;
+    }
+
+    bool const hasLower = hasLowerBound(idx);
+    bool const hasUpper = hasUpperBound(idx);
+    assert(hasLower or hasUpper);
+    if (not hasUpper) {
+        printSmtLib2Bound(os, idx, LowerBound{getLower(idx)});
+        return;
+    }
+    if (not hasLower) {
+        printSmtLib2Bound(os, idx, UpperBound{getUpper(idx)});
+        return;
+    }
+
+    os << "(and ";
+    printSmtLib2Bound(os, idx, LowerBound{getLower(idx)});
+    printSmtLib2Bound(os, idx, UpperBound{getUpper(idx)});
+    os << ')';
+}
+
+void IntervalExplanation::printSmtLib2Bound(std::ostream & os, VarIdx idx, Bound const & bnd) const {
+    os << '(' << bnd.getSymbol() << ' ' << frameworkPtr->getVarName(idx) << ' ';
+    printSmtLib2AsRational(os, bnd.getValue());
+    os << ')';
+}
+
 void IntervalExplanation::printBounds(std::ostream & os, PrintConfig const & conf) const {
     printTp<PrintFormat::bounds>(os, conf);
 }
@@ -218,52 +342,44 @@ void IntervalExplanation::printTp(std::ostream & os, PrintConfig const & conf) c
 
     auto const size_ = size();
     for (VarIdx idx = 0; idx < size_; ++idx) {
-        auto const * optVarBnd = tryGetVarBound(idx);
-        if (includeAll) {
-            if constexpr (isBounds) {
-                printElemBounds(os, conf, idx, optVarBnd);
-            } else {
-                static_assert(isIntervals);
-                printElemInterval(os, conf, idx, optVarBnd);
-            }
-            continue;
-        }
+        if (not includeAll and not contains(idx)) { continue; }
 
-        if (not optVarBnd) { continue; }
-        auto & varBnd = *optVarBnd;
         if constexpr (isBounds) {
-            printElemBounds(os, conf, varBnd);
+            printElemBounds(os, conf, idx);
         } else {
             static_assert(isIntervals);
-            printElemInterval(os, conf, varBnd);
+            printElemInterval(os, conf, idx);
         }
     }
 }
 
-void IntervalExplanation::printElemBounds(std::ostream & os, PrintConfig const & conf, VarBound const & varBnd) {
-    os << varBnd << conf.delim;
-}
+void IntervalExplanation::printElemBounds(std::ostream & os, PrintConfig const & conf, VarIdx idx) const {
+    auto const & varName = frameworkPtr->getVarName(idx);
+    if (not contains(idx)) {
+        os << varName << " free" << conf.delim;
+        return;
+    }
 
-void IntervalExplanation::printElemInterval(std::ostream & os, PrintConfig const & conf,
-                                            VarBound const & varBnd) const {
-    os << varBnd.toInterval() << conf.delim;
-}
+    if (isPoint(idx)) {
+        os << varName << ' ' << EqBound{getLower(idx)} << conf.delim;
+        return;
+    }
 
-void IntervalExplanation::printElemBounds(std::ostream & os, PrintConfig const & conf, VarIdx idx,
-                                          VarBound const * optVarBnd) const {
-    if (optVarBnd) {
-        printElemBounds(os, conf, *optVarBnd);
+    bool const hasLower = hasLowerBound(idx);
+    bool const hasUpper = hasUpperBound(idx);
+    assert(hasLower or hasUpper);
+    if (not hasUpper) {
+        os << varName << ' ' << LowerBound{getLower(idx)} << conf.delim;
+    } else if (not hasLower) {
+        os << varName << ' ' << UpperBound{getUpper(idx)} << conf.delim;
     } else {
-        os << frameworkPtr->getVarName(idx) << " free" << conf.delim;
+        // x >= l && x <= u -> l <= x <= u
+        LowerBound{getLower(idx)}.printReverse(os);
+        os << ' ' << varName << ' ' << UpperBound{getUpper(idx)} << conf.delim;
     }
 }
 
-void IntervalExplanation::printElemInterval(std::ostream & os, PrintConfig const & conf, VarIdx idx,
-                                            VarBound const * optVarBnd) const {
-    if (optVarBnd) {
-        printElemInterval(os, conf, *optVarBnd);
-    } else {
-        os << frameworkPtr->getDomainInterval(idx) << conf.delim;
-    }
+void IntervalExplanation::printElemInterval(std::ostream & os, PrintConfig const & conf, VarIdx idx) const {
+    os << getInterval(idx) << conf.delim;
 }
 } // namespace spexplain
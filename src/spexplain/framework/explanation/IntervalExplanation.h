@@ -1,7 +1,7 @@
 #ifndef SPEXPLAIN_IVALEXPLANATION_H
 #define SPEXPLAIN_IVALEXPLANATION_H
 
-#include "ConjunctExplanation.h"
+#include "Explanation.h"
 
 #include "VarBound.h"
 
@@ -9,42 +9,75 @@
 #include <spexplain/common/Interval.h>
 
 #include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace spexplain {
-//! only some things are shared with ConjunctExplanation but not all - there should be a common base class
-// then it will also hold that IntervalExplanation is not ConjunctExplanation, only e.g. ConjunctExplanationBase
-class IntervalExplanation : public ConjunctExplanation {
+class ConjunctExplanation;
+
+// Dense over all variables: the bounds are stored in contiguous arrays, not as separate VarBound objects
+// The bounds of free variables and the free sides of bounded variables hold the bounds of the domain
+class IntervalExplanation : public Explanation {
 public:
     enum class PrintFormat { smtlib2, bounds, intervals };
 
-    struct PrintConfig : ConjunctExplanation::PrintConfig {
-        bool includeAll;
+    struct PrintConfig {
+        char delim = ' ';
+        bool includeAll = false;
     };
 
-    static constexpr PrintConfig defaultBoundsPrintConfig{{.delim = '\n'}, false};
-    static constexpr PrintConfig defaultIntervalsPrintConfig{{.delim = ' '}, true};
+    static constexpr PrintConfig defaultBoundsPrintConfig{.delim = '\n', .includeAll = false};
+    static constexpr PrintConfig defaultIntervalsPrintConfig{.delim = ' ', .includeAll = true};
 
     explicit IntervalExplanation(Framework const &);
 
     bool supportsVolume() const override { return true; }
 
+    // Including the free variables
     std::size_t size() const {
-        assert(ConjunctExplanation::size() == frameworkPtr->varSize());
-        return ConjunctExplanation::size();
+        assert(lowers.size() == frameworkPtr->varSize());
+        return lowers.size();
     }
 
-    VarBound const * tryGetVarBound(VarIdx idx) const { return castToVarBound(tryGetExplanation(idx)); }
-    VarBound * tryGetVarBound(VarIdx idx) { return castToVarBound(tryGetExplanation(idx)); }
+    bool contains(VarIdx idx) const override { return testBit(presenceMask, idx); }
+
+    bool isPoint(VarIdx idx) const { return testBit(pointMask, idx); }
+    // Not including points
+    bool hasLowerBound(VarIdx) const;
+    bool hasUpperBound(VarIdx) const;
 
-    bool contains(VarIdx idx) const override { return bool(tryGetVarBound(idx)); }
+    Float getLower(VarIdx idx) const {
+        assert(idx < size());
+        return lowers[idx];
+    }
+    Float getUpper(VarIdx idx) const {
+        assert(idx < size());
+        return uppers[idx];
+    }
+    // The domain interval if the variable is free
+    Interval getInterval(VarIdx idx) const { return Interval{getLower(idx), getUpper(idx)}; }
+
+    // Constructed on demand, the accessors above are cheaper
+    std::optional<VarBound> tryGetVarBound(VarIdx) const;
 
     std::size_t varSize() const override;
+    std::size_t termSize() const override;
+
+    void clear() override;
+
+    void swap(IntervalExplanation &);
 
-    void insertVarBound(VarBound);
+    void insertVarBound(VarBound const &);
     void insertBound(VarIdx, Bound);
 
-    bool eraseVarBound(VarIdx idx) { return eraseExplanation(idx); }
+    // The variable becomes free if the interval is equal to the domain
+    void setInterval(VarIdx, Interval const &);
 
+    bool eraseVarBound(VarIdx);
+
+    // It assumes that they have at least some overlap
     void intersect(IntervalExplanation &&);
 
     std::unique_ptr<ConjunctExplanation> toConjunctExplanation(std::vector<VarIdx> const & varOrder) &&;
@@ -53,44 +86,51 @@ public:
     Float getRelativeVolumeSkipFixed() const override;
 
     void print(std::ostream & os) const override;
+    void printSmtLib2(std::ostream & os) const override { printSmtLib2(os, PrintConfig{}); }
     void printBounds(std::ostream & os) const { printBounds(os, defaultBoundsPrintConfig); }
     void printIntervals(std::ostream & os) const { printIntervals(os, defaultIntervalsPrintConfig); }
     void print(std::ostream &, PrintConfig const &) const;
+    void printSmtLib2(std::ostream &, PrintConfig const &) const;
     void printBounds(std::ostream &, PrintConfig const &) const;
     void printIntervals(std::ostream &, PrintConfig const &) const;
 
 protected:
-    std::size_t computeFixedCount() const override;
+    using Mask = std::vector<std::uint64_t>;
 
-    PrintFormat const & getPrintFormat() const;
+    static constexpr std::size_t maskWordBits = 64;
 
-private:
-    static VarBound const * castToVarBound(PartialExplanation const * expPtr) {
-        assert(not expPtr or dynamic_cast<VarBound const *>(expPtr));
-        return static_cast<VarBound const *>(expPtr);
+    static bool testBit(Mask const & mask, VarIdx idx) {
+        return (mask[idx / maskWordBits] >> (idx % maskWordBits)) & 1;
     }
-
-    static VarBound * castToVarBound(PartialExplanation * expPtr) {
-        assert(not expPtr or dynamic_cast<VarBound *>(expPtr));
-        return static_cast<VarBound *>(expPtr);
+    static void setBit(Mask & mask, VarIdx idx) {
+        mask[idx / maskWordBits] |= (std::uint64_t{1} << (idx % maskWordBits));
     }
+    static void resetBit(Mask & mask, VarIdx idx) {
+        mask[idx / maskWordBits] &= ~(std::uint64_t{1} << (idx % maskWordBits));
+    }
+    static std::size_t countBits(Mask const &);
 
-    void insertExplanation(std::unique_ptr<PartialExplanation>) override;
+    std::size_t computeFixedCount() const override;
 
-    void condense() override;
+    PrintFormat const & getPrintFormat() const;
 
-    void intersect(std::unique_ptr<Explanation> &&) override;
-    void intersect(ConjunctExplanation &&) override;
+    void setFree(VarIdx);
 
     template<bool skipFixed>
     Float computeRelativeVolumeTp() const;
 
     template<PrintFormat>
     void printTp(std::ostream &, PrintConfig const &) const;
-    static void printElemBounds(std::ostream &, PrintConfig const &, VarBound const &);
-    void printElemInterval(std::ostream &, PrintConfig const &, VarBound const &) const;
-    void printElemBounds(std::ostream &, PrintConfig const &, VarIdx, VarBound const *) const;
-    void printElemInterval(std::ostream &, PrintConfig const &, VarIdx, VarBound const *) const;
+    void printElemBounds(std::ostream &, PrintConfig const &, VarIdx) const;
+    void printElemInterval(std::ostream &, PrintConfig const &, VarIdx) const;
+    // The same formats as of VarBound, but without constructing it
+    void printElemSmtLib2(std::ostream &, VarIdx) const;
+    void printSmtLib2Bound(std::ostream &, VarIdx, Bound const &) const;
+
+    std::vector<Float> lowers;
+    std::vector<Float> uppers;
+    Mask presenceMask;
+    Mask pointMask;
 };
 } // namespace spexplain
 
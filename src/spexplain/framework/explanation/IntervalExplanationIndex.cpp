@@ -0,0 +1,201 @@
+#include "IntervalExplanationIndex.h"
+
+#include "IntervalExplanation.h"
+#include "VarBound.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace spexplain {
+namespace {
+    // No. boxes used to estimate the spread of the centers of a node
+    constexpr std::size_t maxSplitSamples = 64;
+} // namespace
+
+IntervalExplanationIndex::IntervalExplanationIndex(Framework const & fw) : framework{fw} {
+    std::size_t const varSize = framework.varSize();
+    domainCenters.reserve(varSize);
+    for (VarIdx idx = 0; idx < varSize; ++idx) {
+        auto const & domain = framework.getDomainInterval(idx);
+        domainCenters.push_back((domain.getLower() + domain.getUpper()) / 2);
+    }
+}
+
+IntervalExplanationIndex::Idx IntervalExplanationIndex::insert(IntervalExplanation const & iexplanation) {
+    std::size_t const esize = iexplanation.size();
+    for (VarIdx idx = 0; idx < esize; ++idx) {
+        if (not iexplanation.contains(idx)) { continue; }
+
+        boxEntries.push_back({.var = idx, .lo = iexplanation.getLower(idx), .hi = iexplanation.getUpper(idx)});
+    }
+
+    Idx const boxIdx = size();
+    boxOffsets.push_back(boxEntries.size());
+    return boxIdx;
+}
+
+void IntervalExplanationIndex::build() {
+    std::size_t const nBoxes = size();
+
+    nodes.clear();
+    nodeEntries.clear();
+    order.resize(nBoxes);
+    std::iota(order.begin(), order.end(), Idx{0});
+    if (nBoxes == 0) { return; }
+
+    accumulators.assign(framework.varSize(), {});
+    touchedVars.clear();
+
+    buildNode(0, nBoxes);
+
+    accumulators = {};
+    touchedVars = {};
+}
+
+void IntervalExplanationIndex::buildNode(std::size_t first, std::size_t last) {
+    assert(first < last);
+
+    std::size_t const nodeIdx = nodes.size();
+    nodes.push_back({.entriesBegin = nodeEntries.size(), .entriesEnd = 0, .first = first, .last = last});
+    computeNodeEntries(first, last);
+    nodes[nodeIdx].entriesEnd = nodeEntries.size();
+
+    if (last - first <= maxLeafSize) { return; }
+
+    VarIdx const splitVar = chooseSplitVar(first, last);
+    if (splitVar == invalidVarIdx) { return; }
+
+    std::size_t const mid = first + (last - first) / 2;
+    std::vector<std::pair<Float, Idx>> keys;
+    keys.reserve(last - first);
+    for (std::size_t pos = first; pos < last; ++pos) {
+        keys.emplace_back(getCenter(order[pos], splitVar), order[pos]);
+    }
+    std::ranges::nth_element(keys, keys.begin() + (mid - first));
+    for (std::size_t pos = first; pos < last; ++pos) {
+        order[pos] = keys[pos - first].second;
+    }
+    keys = {};
+
+    buildNode(first, mid);
+    nodes[nodeIdx].rightChild = nodes.size();
+    buildNode(mid, last);
+}
+
+void IntervalExplanationIndex::computeNodeEntries(std::size_t first, std::size_t last) {
+    assert(touchedVars.empty());
+
+    for (std::size_t pos = first; pos < last; ++pos) {
+        for (auto const & [var, lo, hi] : getBoxEntries(order[pos])) {
+            auto & acc = accumulators[var];
+            if (acc.count++ == 0) {
+                touchedVars.push_back(var);
+                acc.lo = lo;
+                acc.hi = hi;
+                continue;
+            }
+            acc.lo = std::min(acc.lo, lo);
+            acc.hi = std::max(acc.hi, hi);
+        }
+    }
+
+    // Features not bounded by all the boxes do not prune anything
+    std::size_t const nodeSize = last - first;
+    std::ranges::sort(touchedVars);
+    for (VarIdx var : touchedVars) {
+        auto & acc = accumulators[var];
+        if (acc.count == nodeSize) { nodeEntries.push_back({.var = var, .lo = acc.lo, .hi = acc.hi}); }
+        acc = {};
+    }
+    touchedVars.clear();
+}
+
+VarIdx IntervalExplanationIndex::chooseSplitVar(std::size_t first, std::size_t last) {
+    assert(touchedVars.empty());
+
+    std::size_t const nodeSize = last - first;
+    std::size_t const nSamples = std::min(nodeSize, maxSplitSamples);
+
+    // The spread is estimated relative to the center of the domain, which is the center of unbounded features
+    for (std::size_t i = 0; i < nSamples; ++i) {
+        Idx const boxIdx = order[first + i * nodeSize / nSamples];
+        for (auto const & [var, lo, hi] : getBoxEntries(boxIdx)) {
+            auto & acc = accumulators[var];
+            if (acc.count++ == 0) { touchedVars.push_back(var); }
+            double const diff = (lo + hi) / 2 - getDomainCenter(var);
+            acc.sum += diff;
+            acc.sumSq += diff * diff;
+        }
+    }
+
+    VarIdx splitVar = invalidVarIdx;
+    double maxVariance = 0;
+    for (VarIdx var : touchedVars) {
+        auto & acc = accumulators[var];
+        double const mean = acc.sum / nSamples;
+        double const variance = acc.sumSq / nSamples - mean * mean;
+        if (variance > maxVariance) {
+            maxVariance = variance;
+            splitVar = var;
+        }
+        acc = {};
+    }
+    touchedVars.clear();
+
+    return splitVar;
+}
+
+Float IntervalExplanationIndex::getCenter(Idx idx, VarIdx var) const {
+    auto const entries = getBoxEntries(idx);
+    auto const it = std::ranges::lower_bound(entries, var, {}, &Entry::var);
+    if (it == entries.end() or it->var != var) { return getDomainCenter(var); }
+    return (it->lo + it->hi) / 2;
+}
+
+bool IntervalExplanationIndex::contains(std::span<Entry const> entries, Network::SampleView point) {
+    for (auto const & [var, lo, hi] : entries) {
+        Float const val = point[var];
+        if (val < lo or val > hi) { return false; }
+    }
+    return true;
+}
+
+void IntervalExplanationIndex::find(Network::SampleView point, std::vector<Idx> & result) const {
+    assert(point.size() == framework.varSize());
+    assert(not (nodes.empty() and size() > 0));
+    if (nodes.empty()) { return; }
+
+    std::size_t const resultBegin = result.size();
+
+    std::vector<std::size_t> stack{0};
+    while (not stack.empty()) {
+        auto const & node = nodes[stack.back()];
+        std::size_t const nodeIdx = stack.back();
+        stack.pop_back();
+
+        if (not contains(getNodeEntries(node), point)) { continue; }
+
+        if (not node.isLeaf()) {
+            stack.push_back(node.rightChild);
+            stack.push_back(nodeIdx + 1);
+            continue;
+        }
+
+        for (std::size_t pos = node.first; pos < node.last; ++pos) {
+            Idx const boxIdx = order[pos];
+            if (contains(getBoxEntries(boxIdx), point)) { result.push_back(boxIdx); }
+        }
+    }
+
+    std::sort(result.begin() + resultBegin, result.end());
+}
+
+Network::Values IntervalExplanationIndex::makeCenter(Idx idx) const {
+    Network::Values center = domainCenters;
+    for (auto const & [var, lo, hi] : getBoxEntries(idx)) {
+        center[var] = (lo + hi) / 2;
+    }
+    return center;
+}
+} // namespace spexplain
@@ -0,0 +1,102 @@
+#ifndef SPEXPLAIN_INTERVALEXPLANATIONINDEX_H
+#define SPEXPLAIN_INTERVALEXPLANATIONINDEX_H
+
+#include "../Framework.h"
+
+#include <spexplain/common/Var.h>
+#include <spexplain/network/Network.h>
+
+#include <span>
+#include <vector>
+
+namespace spexplain {
+class IntervalExplanation;
+
+// Bounding volume hierarchy over the boxes of interval explanations, answering which boxes contain a point
+// The boxes are sparse: only the bounded features are stored, both in the boxes and in the nodes,
+// where a node only keeps the features that are bounded by all the boxes within
+class IntervalExplanationIndex {
+public:
+    using Idx = std::size_t;
+
+    static constexpr std::size_t maxLeafSize = 16;
+
+    IntervalExplanationIndex(Framework const &);
+
+    std::size_t size() const { return boxOffsets.size() - 1; }
+
+    // The index of the box is the no. boxes inserted before, it must be built again afterwards
+    Idx insert(IntervalExplanation const &);
+
+    void build();
+
+    // Appends the indices of all boxes that contain the point, in ascending order
+    void find(Network::SampleView, std::vector<Idx> &) const;
+
+    // Any point of the box, e.g. to compute its classification
+    Network::Values makeCenter(Idx) const;
+
+protected:
+    struct Entry {
+        VarIdx var;
+        Float lo;
+        Float hi;
+    };
+
+    struct Node {
+        // Range within `nodeEntries`
+        std::size_t entriesBegin;
+        std::size_t entriesEnd;
+        // Range within `order`
+        std::size_t first;
+        std::size_t last;
+        // The left child immediately follows its parent
+        std::size_t rightChild{};
+
+        bool isLeaf() const { return rightChild == 0; }
+    };
+
+    std::span<Entry const> getBoxEntries(Idx idx) const {
+        return {boxEntries.data() + boxOffsets[idx], boxEntries.data() + boxOffsets[idx + 1]};
+    }
+    std::span<Entry const> getNodeEntries(Node const & node) const {
+        return {nodeEntries.data() + node.entriesBegin, nodeEntries.data() + node.entriesEnd};
+    }
+
+    static bool contains(std::span<Entry const>, Network::SampleView);
+
+    Float getCenter(Idx, VarIdx) const;
+    Float getDomainCenter(VarIdx idx) const { return domainCenters[idx]; }
+
+    void buildNode(std::size_t first, std::size_t last);
+    void computeNodeEntries(std::size_t first, std::size_t last);
+    // Returns invalidVarIdx if the boxes cannot be told apart
+    VarIdx chooseSplitVar(std::size_t first, std::size_t last);
+
+    Framework const & framework;
+
+    Network::Values domainCenters{};
+
+    // Sparse rows of all boxes, sorted by the features
+    std::vector<Entry> boxEntries{};
+    std::vector<std::size_t> boxOffsets{0};
+
+    std::vector<Node> nodes{};
+    std::vector<Entry> nodeEntries{};
+    // Indices of the boxes in the order of the leaves
+    std::vector<Idx> order{};
+
+    // Dense buffers used during the build
+    struct Accumulator {
+        std::size_t count{};
+        Float lo{};
+        Float hi{};
+        double sum{};
+        double sumSq{};
+    };
+    std::vector<Accumulator> accumulators{};
+    std::vector<VarIdx> touchedVars{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_INTERVALEXPLANATIONINDEX_H
@@ -11,13 +11,22 @@
 
 #include <cassert>
 #include <ostream>
+#include <utility>
 
 namespace spexplain::opensmt {
 FormulaExplanation::FormulaExplanation(Framework const & fw, Formula const & phi)
     : Explanation{fw},
       formulaPtr{MAKE_UNIQUE(phi)} {}
 
+FormulaExplanation::FormulaExplanation(Framework const & fw, xai::verifiers::OpenSMTVerifier const & verifier,
+                                       Formula const & phi)
+    : FormulaExplanation(fw, phi) {
+    verifierPtr = &verifier;
+}
+
 xai::verifiers::OpenSMTVerifier const & FormulaExplanation::getVerifier() const {
+    if (verifierPtr) { return *verifierPtr; }
+
     assert(dynamic_cast<xai::verifiers::OpenSMTVerifier const *>(&getExpand().getVerifier()));
     return static_cast<xai::verifiers::OpenSMTVerifier const &>(getExpand().getVerifier());
 }
@@ -46,6 +55,7 @@ void FormulaExplanation::swap(FormulaExplanation & rhs) {
     Explanation::swap(rhs);
 
     formulaPtr.swap(rhs.formulaPtr);
+    std::swap(verifierPtr, rhs.verifierPtr);
 }
 
 void FormulaExplanation::intersect(FormulaExplanation && rhs) {
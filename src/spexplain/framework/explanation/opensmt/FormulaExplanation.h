@@ -20,6 +20,8 @@ class FormulaExplanation : public Explanation {
 public:
     using Explanation::Explanation;
     explicit FormulaExplanation(Framework const &, Formula const &);
+    // The formula belongs to the given verifier rather than to the one of the framework
+    explicit FormulaExplanation(Framework const &, xai::verifiers::OpenSMTVerifier const &, Formula const &);
 
     Formula const & getFormula() const { return *formulaPtr; }
 
@@ -41,6 +43,8 @@ protected:
     void resetFormula();
 
     std::unique_ptr<Formula> formulaPtr{};
+
+    xai::verifiers::OpenSMTVerifier const * verifierPtr{};
 };
 } // namespace spexplain::opensmt
 
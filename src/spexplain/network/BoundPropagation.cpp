@@ -0,0 +1,291 @@
+#include "BoundPropagation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace spexplain {
+namespace {
+    // Bound of the rounding error of a floating-point sum of `n` addends with the sum of their magnitudes
+    Float roundingError(std::size_t n, Float sumAbs) {
+        constexpr Float eps = std::numeric_limits<Float>::epsilon();
+        return static_cast<Float>(n + 2) * eps * sumAbs + std::numeric_limits<Float>::min();
+    }
+
+    Float magnitude(Float lo, Float hi) { return std::max(std::abs(lo), std::abs(hi)); }
+} // namespace
+
+Network::BoundPropagation::BoundPropagation(Network const & nw, Type tp) : network{nw}, type{tp} {
+    std::size_t const nLayers = network.nLayers();
+    lowerBounds.resize(nLayers);
+    upperBounds.resize(nLayers);
+    for (std::size_t layer = 0; layer < nLayers; ++layer) {
+        std::size_t const layerSize = network.getLayerSize(layer);
+        lowerBounds[layer].resize(layerSize);
+        upperBounds[layer].resize(layerSize);
+    }
+
+    if (type != Type::symbolic) { return; }
+
+    exactLowerBounds = lowerBounds;
+    exactUpperBounds = upperBounds;
+    deviations = lowerBounds;
+}
+
+void Network::BoundPropagation::operator()(std::span<Float const> inputLowerBounds_,
+                                           std::span<Float const> inputUpperBounds_) {
+    std::size_t const nInputs = network.nInputs();
+    assert(inputLowerBounds_.size() == nInputs);
+    assert(inputUpperBounds_.size() == nInputs);
+
+    inputLowerBounds.assign(inputLowerBounds_.begin(), inputLowerBounds_.end());
+    inputUpperBounds.assign(inputUpperBounds_.begin(), inputUpperBounds_.end());
+
+    bool const symbolic = (type == Type::symbolic);
+    if (symbolic) {
+        // The last one is the magnitude of the constant term of the expressions
+        inputMagnitudes.resize(nInputs + 1);
+        for (std::size_t i = 0; i < nInputs; ++i) {
+            inputMagnitudes[i] = magnitude(inputLowerBounds[i], inputUpperBounds[i]);
+        }
+        inputMagnitudes[nInputs] = 1;
+    }
+
+    for (std::size_t i = 0; i < nInputs; ++i) {
+        assert(inputLowerBounds[i] <= inputUpperBounds[i]);
+        lowerBounds[0][i] = inputLowerBounds[i] - constantsError;
+        upperBounds[0][i] = inputUpperBounds[i] + constantsError;
+    }
+
+    if (symbolic) {
+        exactLowerBounds[0] = inputLowerBounds;
+        exactUpperBounds[0] = inputUpperBounds;
+        std::ranges::fill(deviations[0], constantsError);
+    }
+
+    std::size_t const nLayers = network.nLayers();
+    for (std::size_t layer = 1; layer < nLayers; ++layer) {
+        computeIntervals(layer);
+        if (not symbolic) { continue; }
+
+        computeSymbolic(layer);
+        if (layer < nLayers - 1) { relaxActivations(layer); }
+    }
+}
+
+void Network::BoundPropagation::computeIntervals(std::size_t layer) {
+    assert(layer > 0);
+    std::size_t const prevLayer = layer - 1;
+    std::size_t const layerSize = network.getLayerSize(layer);
+    std::size_t const prevLayerSize = network.getLayerSize(prevLayer);
+
+    auto const & prevLower = lowerBounds[prevLayer];
+    auto const & prevUpper = upperBounds[prevLayer];
+    auto const activation = [prevLayer](Float val) { return (prevLayer == 0) ? val : std::max(Float{0}, val); };
+
+    for (std::size_t node = 0; node < layerSize; ++node) {
+        auto const weights = network.getWeights(layer, node);
+        assert(weights.size() == prevLayerSize);
+        Float const bias = network.getBias(layer, node);
+
+        Float lo = bias;
+        Float hi = bias;
+        Float sumAbs = std::abs(bias);
+        Float sumMagnitudes = 0;
+        for (std::size_t j = 0; j < prevLayerSize; ++j) {
+            Float const w = weights[j];
+            Float const prevLo = activation(prevLower[j]);
+            Float const prevHi = activation(prevUpper[j]);
+            if (w >= 0) {
+                lo += w * prevLo;
+                hi += w * prevHi;
+            } else {
+                lo += w * prevHi;
+                hi += w * prevLo;
+            }
+            Float const mag = magnitude(prevLo, prevHi);
+            sumAbs += std::abs(w) * mag;
+            sumMagnitudes += mag;
+        }
+
+        Float const slack = constantsError * (1 + sumMagnitudes) + roundingError(prevLayerSize, sumAbs);
+        lowerBounds[layer][node] = lo - slack;
+        upperBounds[layer][node] = hi + slack;
+    }
+}
+
+void Network::BoundPropagation::computeSymbolic(std::size_t layer) {
+    assert(type == Type::symbolic);
+    assert(layer > 0);
+    std::size_t const prevLayer = layer - 1;
+    std::size_t const layerSize = network.getLayerSize(layer);
+    std::size_t const prevLayerSize = network.getLayerSize(prevLayer);
+    std::size_t const nVars = network.nInputs();
+
+    lowerExprs.nVars = nVars;
+    upperExprs.nVars = nVars;
+    lowerExprs.coefs.assign(layerSize * (nVars + 1), 0);
+    upperExprs.coefs.assign(layerSize * (nVars + 1), 0);
+
+    auto const & prevLower = lowerBounds[prevLayer];
+    auto const & prevUpper = upperBounds[prevLayer];
+    auto const & prevDeviations = deviations[prevLayer];
+    auto const activation = [prevLayer](Float val) { return (prevLayer == 0) ? val : std::max(Float{0}, val); };
+
+    for (std::size_t node = 0; node < layerSize; ++node) {
+        auto const weights = network.getWeights(layer, node);
+        Float const bias = network.getBias(layer, node);
+
+        auto lowerExpr = lowerExprs[node];
+        auto upperExpr = upperExprs[node];
+        lowerExpr[nVars] = bias;
+        upperExpr[nVars] = bias;
+
+        Float deviation = constantsError;
+        // Magnitudes of the addends of the coefficients over the input box
+        Float lowerSumAbs = 0;
+        Float upperSumAbs = 0;
+        for (std::size_t j = 0; j < prevLayerSize; ++j) {
+            Float const w = weights[j];
+            deviation += constantsError * magnitude(activation(prevLower[j]), activation(prevUpper[j]));
+            deviation += (std::abs(w) + constantsError) * prevDeviations[j];
+            if (w == 0) { continue; }
+
+            // The inputs themselves are the expressions
+            if (prevLayer == 0) {
+                lowerExpr[j] += w;
+                upperExpr[j] += w;
+                continue;
+            }
+
+            auto const srcLowerExpr = (w > 0) ? prevLowerExprs[j] : prevUpperExprs[j];
+            auto const srcUpperExpr = (w > 0) ? prevUpperExprs[j] : prevLowerExprs[j];
+            for (std::size_t k = 0; k <= nVars; ++k) {
+                lowerExpr[k] += w * srcLowerExpr[k];
+                upperExpr[k] += w * srcUpperExpr[k];
+                lowerSumAbs += std::abs(w * srcLowerExpr[k]) * inputMagnitudes[k];
+                upperSumAbs += std::abs(w * srcUpperExpr[k]) * inputMagnitudes[k];
+            }
+        }
+
+        // The rounding of the coefficients is covered by widening the constant terms
+        // (exact for the first hidden layer, which just copies the weights)
+        if (prevLayer > 0) {
+            lowerExpr[nVars] -= roundingError(prevLayerSize + 1, lowerSumAbs);
+            upperExpr[nVars] += roundingError(prevLayerSize + 1, upperSumAbs);
+        }
+
+        // Both the symbolic and the interval bounds are valid, so take the tighter ones
+        Float & exactLo = exactLowerBounds[layer][node];
+        Float & exactHi = exactUpperBounds[layer][node];
+        Float & lo = lowerBounds[layer][node];
+        Float & hi = upperBounds[layer][node];
+        exactLo = std::max(concretizeLower(lowerExpr), lo);
+        exactHi = std::min(concretizeUpper(upperExpr), hi);
+        if (exactLo > exactHi) { exactLo = exactHi = (exactLo + exactHi) / 2; }
+
+        deviations[layer][node] = deviation;
+        lo = std::max(lo, exactLo - deviation);
+        hi = std::min(hi, exactHi + deviation);
+    }
+}
+
+void Network::BoundPropagation::relaxActivations(std::size_t layer) {
+    assert(type == Type::symbolic);
+    assert(layer > 0 and layer < network.nLayers() - 1);
+    std::size_t const layerSize = network.getLayerSize(layer);
+    std::size_t const nVars = network.nInputs();
+
+    for (std::size_t node = 0; node < layerSize; ++node) {
+        Float const lo = exactLowerBounds[layer][node];
+        Float const hi = exactUpperBounds[layer][node];
+        auto lowerExpr = lowerExprs[node];
+        auto upperExpr = upperExprs[node];
+
+        if (lo >= 0) { continue; }
+
+        if (hi <= 0) {
+            std::ranges::fill(lowerExpr, 0);
+            std::ranges::fill(upperExpr, 0);
+            continue;
+        }
+
+        // The upper bound is the line connecting (lo, 0) and (hi, hi)
+        // The slope is rounded up, which keeps the line above the activation on [lo, hi]
+        Float const slope = std::nextafter(hi / (hi - lo), std::numeric_limits<Float>::infinity());
+        Float sumAbs = std::abs(slope * lo);
+        for (std::size_t k = 0; k <= nVars; ++k) {
+            Float & coef = upperExpr[k];
+            coef *= slope;
+            sumAbs += std::abs(coef) * inputMagnitudes[k];
+        }
+        upperExpr[nVars] -= slope * lo;
+        // The rounding of the scaled coefficients and of the intercept
+        upperExpr[nVars] += roundingError(nVars + 2, sumAbs);
+
+        // The lower bound is either 0 or the identity, whichever has the smaller area
+        if (hi <= -lo) { std::ranges::fill(lowerExpr, 0); }
+    }
+
+    std::swap(prevLowerExprs, lowerExprs);
+    std::swap(prevUpperExprs, upperExprs);
+}
+
+Float Network::BoundPropagation::concretizeLower(std::span<Float const> expr) const {
+    std::size_t const nVars = inputLowerBounds.size();
+    assert(expr.size() == nVars + 1);
+
+    Float val = expr[nVars];
+    Float sumAbs = std::abs(val);
+    for (std::size_t k = 0; k < nVars; ++k) {
+        Float const coef = expr[k];
+        val += coef * ((coef >= 0) ? inputLowerBounds[k] : inputUpperBounds[k]);
+        sumAbs += std::abs(coef) * magnitude(inputLowerBounds[k], inputUpperBounds[k]);
+    }
+
+    return val - roundingError(2 * nVars, sumAbs);
+}
+
+Float Network::BoundPropagation::concretizeUpper(std::span<Float const> expr) const {
+    std::size_t const nVars = inputLowerBounds.size();
+    assert(expr.size() == nVars + 1);
+
+    Float val = expr[nVars];
+    Float sumAbs = std::abs(val);
+    for (std::size_t k = 0; k < nVars; ++k) {
+        Float const coef = expr[k];
+        val += coef * ((coef >= 0) ? inputUpperBounds[k] : inputLowerBounds[k]);
+        sumAbs += std::abs(coef) * magnitude(inputLowerBounds[k], inputUpperBounds[k]);
+    }
+
+    return val + roundingError(2 * nVars, sumAbs);
+}
+
+Float Network::BoundPropagation::getOutputDifferenceLowerBound(std::size_t node, std::size_t otherNode) const {
+    std::size_t const outputLayer = network.nLayers() - 1;
+    assert(node != otherNode);
+
+    Float const intervalBound = getLowerBound(outputLayer, node) - getUpperBound(outputLayer, otherNode);
+    if (type != Type::symbolic) { return intervalBound; }
+
+    // The common dependencies on the inputs partially cancel out
+    std::size_t const nVars = network.nInputs();
+    auto const lowerExpr = lowerExprs[node];
+    auto const upperExpr = upperExprs[otherNode];
+    Values diffExpr(nVars + 1);
+    Float sumAbs = 0;
+    for (std::size_t k = 0; k <= nVars; ++k) {
+        diffExpr[k] = lowerExpr[k] - upperExpr[k];
+        sumAbs += std::abs(diffExpr[k]) * inputMagnitudes[k];
+    }
+    // The rounding of the subtractions
+    diffExpr[nVars] -= roundingError(1, sumAbs);
+
+    auto const & outputDeviations = deviations[outputLayer];
+    Float const symbolicBound =
+        concretizeLower(diffExpr) - outputDeviations[node] - outputDeviations[otherNode];
+
+    return std::max(intervalBound, symbolicBound);
+}
+} // namespace spexplain
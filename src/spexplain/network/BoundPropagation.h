@@ -0,0 +1,103 @@
+#ifndef SPEXPLAIN_BOUNDPROPAGATION_H
+#define SPEXPLAIN_BOUNDPROPAGATION_H
+
+#include "Network.h"
+
+#include <cassert>
+#include <span>
+#include <vector>
+
+namespace spexplain {
+// Over-approximates the values of the neurons for a box of the inputs
+// The bounds are widened to cover the floating-point rounding of the computation itself,
+// including the coefficients of the symbolic expressions, and also the constants of the network and of the box perturbed by at most `constantsError`
+// (e.g. if the consumer uses their approximations)
+class Network::BoundPropagation {
+public:
+    enum class Type {
+        // Plain interval arithmetic
+        interval,
+        // Additionally propagates linear bounds in terms of the inputs (with DeepPoly-style relaxation of ReLU)
+        symbolic
+    };
+
+    explicit BoundPropagation(Network const &, Type = Type::interval);
+
+    Network const & getNetwork() const { return network; }
+
+    Type getType() const { return type; }
+
+    // Zero by default: the verifiers take the constants exactly as they are, e.g. OpenSMT converts them to rationals
+    // exactly and Marabou computes with the same floating-point values
+    void setConstantsError(Float err) { constantsError = err; }
+    Float getConstantsError() const { return constantsError; }
+
+    // Assumes that the box is not empty
+    void operator()(std::span<Float const> inputLowerBounds, std::span<Float const> inputUpperBounds);
+
+    // Bounds of the neurons before the activation function, layer > 0
+    Float getLowerBound(std::size_t layer, std::size_t node) const {
+        assert(layer > 0);
+        return lowerBounds[layer][node];
+    }
+    Float getUpperBound(std::size_t layer, std::size_t node) const {
+        assert(layer > 0);
+        return upperBounds[layer][node];
+    }
+
+    bool isStablyActive(std::size_t layer, std::size_t node) const { return getLowerBound(layer, node) > 0; }
+    bool isStablyInactive(std::size_t layer, std::size_t node) const { return getUpperBound(layer, node) < 0; }
+
+    // Lower bound of the difference `output[node] - output[otherNode]`
+    Float getOutputDifferenceLowerBound(std::size_t node, std::size_t otherNode) const;
+
+protected:
+    // Linear expressions over the inputs, row-major, the last column is the constant
+    struct Expressions {
+        std::size_t nVars{};
+        Values coefs{};
+
+        std::span<Float> operator[](std::size_t node) { return {coefs.data() + node * (nVars + 1), nVars + 1}; }
+        std::span<Float const> operator[](std::size_t node) const {
+            return {coefs.data() + node * (nVars + 1), nVars + 1};
+        }
+    };
+
+    void computeIntervals(std::size_t layer);
+    void computeSymbolic(std::size_t layer);
+
+    void relaxActivations(std::size_t layer);
+
+    Float concretizeLower(std::span<Float const>) const;
+    Float concretizeUpper(std::span<Float const>) const;
+
+    Network const & network;
+
+    Type type;
+
+    Float constantsError{};
+
+    // Per layer, the input layer holds the (widened) input box
+    std::vector<Values> lowerBounds{};
+    std::vector<Values> upperBounds{};
+
+    // Symbolic only: bounds of the neurons of the network as is, without the perturbation
+    std::vector<Values> exactLowerBounds{};
+    std::vector<Values> exactUpperBounds{};
+    // Symbolic only: maximal deviation of the neurons caused by the perturbation
+    std::vector<Values> deviations{};
+
+    // Symbolic only: the expressions of the current layer, and of the output layer after the propagation
+    Expressions lowerExprs{};
+    Expressions upperExprs{};
+    Expressions prevLowerExprs{};
+    Expressions prevUpperExprs{};
+
+    Values inputLowerBounds{};
+    Values inputUpperBounds{};
+    // Symbolic only: the magnitudes of the inputs, with 1 for the constant term
+    Values inputMagnitudes{};
+};
+} // namespace spexplain
+
+#endif // SPEXPLAIN_BOUNDPROPAGATION_H
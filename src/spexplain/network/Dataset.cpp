@@ -1,11 +1,16 @@
 #include "Dataset.h"
 
-#include <fstream>
+#include <spexplain/common/MappedFile.h>
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
 #include <numeric>
 #include <ostream>
 #include <ranges>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 
 #ifndef NDEBUG
@@ -13,53 +18,148 @@
 #endif
 
 namespace spexplain {
-Network::Dataset::Dataset(Network const & network, std::string_view fileName)
-    : Dataset(network.nInputs(), network.nClasses(), fileName) {}
+namespace {
+    // Smaller files are not worth parsing in parallel
+    constexpr std::size_t minChunkSize = std::size_t{1} << 20;
+
+    struct ParsedChunk {
+        Network::Values samplesValues{};
+        Network::Values labels{};
+    };
+
+    bool isBlank(char c) { return c == ' ' or c == '\t' or c == '\r'; }
+
+    char const * skipBlanks(char const * it, char const * end) {
+        while (it != end and isBlank(*it)) {
+            ++it;
+        }
+        return it;
+    }
+
+    // Each line consists of the values of a sample followed by the expected class
+    void parseChunk(ParsedChunk & chunk, char const * begin, char const * end, std::size_t nInputs,
+                    std::string_view fileName) {
+        auto & [samplesValues, labels] = chunk;
+        std::size_t const rowSize = nInputs + 1;
+
+        char const * it = begin;
+        while (it != end) {
+            char const * const lineEnd = std::find(it, end, '\n');
+            it = skipBlanks(it, lineEnd);
+            if (it == lineEnd) {
+                it = (lineEnd == end) ? end : lineEnd + 1;
+                continue;
+            }
+
+            std::size_t const rowBegin = samplesValues.size();
+            while (true) {
+                Float val;
+                auto const [ptr, ec] = std::from_chars(it, lineEnd, val);
+                if (ec != std::errc{}) {
+                    auto const fieldEnd = std::find(it, lineEnd, ',');
+                    throw std::logic_error{"Invalid value in dataset file "s + std::string{fileName} + ": '" +
+                                           std::string{it, fieldEnd} + "'"};
+                }
+                samplesValues.push_back(val);
+
+                it = skipBlanks(ptr, lineEnd);
+                if (it == lineEnd) { break; }
+                if (*it != ',') {
+                    throw std::logic_error{"Unexpected character in dataset file "s + std::string{fileName} + ": '" +
+                                           *it + "'"};
+                }
+                it = skipBlanks(it + 1, lineEnd);
+            }
+
+            if (samplesValues.size() - rowBegin != rowSize) {
+                throw std::logic_error{"Unexpected no. values in a row of dataset file "s + std::string{fileName} +
+                                       ": " + std::to_string(samplesValues.size() - rowBegin) +
+                                       ", expected: " + std::to_string(rowSize)};
+            }
+            labels.push_back(samplesValues.back());
+            samplesValues.pop_back();
+
+            it = (lineEnd == end) ? end : lineEnd + 1;
+        }
+    }
+} // namespace
+
+Network::Dataset::Dataset(Network const & network, std::string_view fileName, std::size_t nThreads)
+    : Dataset(network.nInputs(), network.nClasses(), fileName, nThreads) {}
 
-Network::Dataset::Dataset(std::size_t nInputs_, std::size_t nClasses_, std::string_view fileName)
+Network::Dataset::Dataset(std::size_t nInputs_, std::size_t nClasses_, std::string_view fileName,
+                          std::size_t nThreads)
     : _nInputs{nInputs_},
       _nClasses{nClasses_} {
-    std::ifstream file{std::string{fileName}};
-    if (not file.good()) { throw std::ifstream::failure{"Could not open dataset file "s + std::string{fileName}}; }
+    MappedFile const file{fileName};
 
     for (std::size_t label = 0; label < nClasses_; ++label) {
         getSampleIndicesOfClass(label);
     }
 
-    // Read the first line to skip the header
-    std::string header;
-    getline(file, header);
-
-    std::string line;
-    Sample::Idx idx{};
-    while (std::getline(file, line)) {
-        std::istringstream ss{line};
-        std::string field;
-        Sample sample;
-        while (std::getline(ss, field, ',')) {
-            sample.push_back(std::stod(field));
+    char const * const fileBegin = reinterpret_cast<char const *>(file.data());
+    char const * const fileEnd = fileBegin + file.size();
+
+    // Skip the header
+    char const * dataBegin = std::find(fileBegin, fileEnd, '\n');
+    if (dataBegin != fileEnd) { ++dataBegin; }
+
+    // The chunks are split at line boundaries
+    std::size_t const dataSize = fileEnd - dataBegin;
+    std::size_t const nChunks = std::max<std::size_t>(1, std::min(nThreads, dataSize / minChunkSize));
+    std::vector<char const *> chunkBounds{dataBegin};
+    for (std::size_t i = 1; i < nChunks; ++i) {
+        char const * const approxBound = std::max(dataBegin + i * (dataSize / nChunks), chunkBounds.back());
+        char const * bound = std::find(approxBound, fileEnd, '\n');
+        if (bound != fileEnd) { ++bound; }
+        chunkBounds.push_back(bound);
+    }
+    chunkBounds.push_back(fileEnd);
+
+    std::vector<ParsedChunk> chunks(nChunks);
+    if (nChunks == 1) {
+        parseChunk(chunks.front(), dataBegin, fileEnd, nInputs_, fileName);
+    } else {
+        std::vector<std::exception_ptr> exceptions(nChunks);
+        std::vector<std::thread> threads;
+        threads.reserve(nChunks);
+        for (std::size_t i = 0; i < nChunks; ++i) {
+            threads.emplace_back([&, i] {
+                try {
+                    parseChunk(chunks[i], chunkBounds[i], chunkBounds[i + 1], nInputs_, fileName);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                }
+            });
         }
-        assert(not sample.empty());
-        Float expectedClassFloat = sample.back();
-        assert(expectedClassFloat == std::floor(expectedClassFloat));
-        sample.pop_back();
-        samples.push_back(std::move(sample));
-
-        Classification::Label label = expectedClassFloat;
-        expectedClassifications.push_back({.label = label});
-#ifndef NDEBUG
-        expectedClassificationLabels.insert(label);
-#endif
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        for (auto & exceptionPtr : exceptions) {
+            if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+        }
+    }
 
-        SampleIndices & sampleIndicesOfClass = getSampleIndicesOfClass(label);
-        sampleIndicesOfClass.push_back(idx);
+    std::size_t totalSize = 0;
+    for (auto const & chunk : chunks) {
+        totalSize += chunk.labels.size();
+    }
+    samplesValues.reserve(totalSize * nInputs_);
+    expectedClassifications.reserve(totalSize);
+
+    for (auto & chunk : chunks) {
+        samplesValues.insert(samplesValues.end(), chunk.samplesValues.begin(), chunk.samplesValues.end());
+        chunk.samplesValues = {};
 
-        ++idx;
+        for (Float expectedClassFloat : chunk.labels) {
+            assert(expectedClassFloat == std::floor(expectedClassFloat));
+            Classification::Label label = expectedClassFloat;
+            pushExpectedClassification(label);
+        }
     }
 
-    assert(not samples.empty());
-    assert(size() == samples.size());
-    assert(size() == expectedClassifications.size());
+    assert(size() > 0);
+    assert(samplesValues.size() == size() * nInputs_);
 
     assert(nClasses_ >= 2);
     assert(expectedClassificationLabels.size() <= nClasses_);
@@ -67,6 +167,36 @@ Network::Dataset::Dataset(std::size_t nInputs_, std::size_t nClasses_, std::stri
     assert(sampleIndicesOfClasses.size() == nClasses_);
 }
 
+Network::Dataset::Dataset(Network const & network, Values samplesValues_, Classifications expectedClassifications_)
+    : _nInputs{network.nInputs()},
+      _nClasses{network.nClasses()} {
+    assert(samplesValues_.size() == expectedClassifications_.size() * nInputs());
+
+    for (std::size_t label = 0; label < nClasses(); ++label) {
+        getSampleIndicesOfClass(label);
+    }
+
+    samplesValues = std::move(samplesValues_);
+    expectedClassifications.reserve(expectedClassifications_.size());
+    for (auto const & cls : expectedClassifications_) {
+        pushExpectedClassification(cls.label);
+    }
+
+    assert(size() > 0);
+    assert(sampleIndicesOfClasses.size() == nClasses());
+}
+
+void Network::Dataset::pushExpectedClassification(Classification::Label label) {
+    Sample::Idx const idx = size();
+    expectedClassifications.push_back({.label = label});
+#ifndef NDEBUG
+    expectedClassificationLabels.insert(label);
+#endif
+
+    SampleIndices & sampleIndicesOfClass = getSampleIndicesOfClass(label);
+    sampleIndicesOfClass.push_back(idx);
+}
+
 Network::Dataset::SampleIndices Network::Dataset::getSampleIndices() const {
     SampleIndices indices(size());
     std::iota(indices.begin(), indices.end(), 0);
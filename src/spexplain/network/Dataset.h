@@ -7,6 +7,7 @@
 
 #include <cassert>
 #include <iosfwd>
+#include <span>
 #include <string_view>
 
 #ifndef NDEBUG
@@ -16,22 +17,25 @@
 namespace spexplain {
 class Network::Dataset {
 public:
-    using Samples = std::vector<Sample>;
     using SampleIndices = std::vector<Sample::Idx>;
     using Outputs = std::vector<Output>;
 
-    Dataset(Network const &, std::string_view fileName);
-    Dataset(std::size_t nInputs_, std::size_t nClasses_, std::string_view fileName);
+    // Large files are parsed by chunks in parallel using at most `nThreads`
+    Dataset(Network const &, std::string_view fileName, std::size_t nThreads = 1);
+    Dataset(std::size_t nInputs_, std::size_t nClasses_, std::string_view fileName, std::size_t nThreads = 1);
+    // Samples given directly (e.g. received at runtime) as a row-major matrix of their values
+    Dataset(Network const &, Values samplesValues_, Classifications expectedClassifications_);
 
     std::size_t nInputs() const { return _nInputs; }
     std::size_t nClasses() const { return _nClasses; }
 
-    std::size_t size() const { return getSamples().size(); }
+    std::size_t size() const { return expectedClassifications.size(); }
 
-    Samples const & getSamples() const { return samples; }
-    Sample const & getSample(Sample::Idx idx) const {
+    // Row-major matrix of the values of all samples
+    std::span<Float const> getSamplesValues() const { return samplesValues; }
+    SampleView getSample(Sample::Idx idx) const {
         assert(idx < size());
-        return samples[idx];
+        return {samplesValues.data() + idx * nInputs(), nInputs()};
     }
 
     SampleIndices getSampleIndices() const;
@@ -62,10 +66,12 @@ public:
     SampleIndices const & getIncorrectSampleIndicesOfExpectedClass(Classification::Label) const;
 
 protected:
+    void pushExpectedClassification(Classification::Label);
+
     void setCorrectAndIncorrectSamples();
 
     // The original order of the samples should remain unchanged
-    Samples samples{};
+    Values samplesValues{};
 
     Classifications expectedClassifications{};
 
@@ -1,13 +1,23 @@
 #include "Network.h"
 
+#include <spexplain/common/MappedFile.h>
+
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
-#include <numeric>
+#include <limits>
 #include <ranges>
 #include <sstream>
 
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
 namespace spexplain {
 namespace {
     std::vector<std::string> split(std::string const & s, char delimiter) {
@@ -29,8 +39,95 @@ namespace {
         return values;
     }
 
+    // The lanes are summed up in a fixed order regardless of the available instruction set
+    constexpr std::size_t dotLanes = 8;
+
+    Float dot(Float const * lhs, Float const * rhs, std::size_t size) {
+        std::size_t const vecSize = size - size % dotLanes;
+        alignas(64) Float acc[dotLanes];
+#if defined(__AVX512F__)
+        __m512d vacc = _mm512_setzero_pd();
+        for (std::size_t k = 0; k < vecSize; k += dotLanes) {
+            vacc = _mm512_add_pd(vacc, _mm512_mul_pd(_mm512_loadu_pd(lhs + k), _mm512_loadu_pd(rhs + k)));
+        }
+        _mm512_store_pd(acc, vacc);
+#elif defined(__AVX__)
+        __m256d vaccLo = _mm256_setzero_pd();
+        __m256d vaccHi = _mm256_setzero_pd();
+        for (std::size_t k = 0; k < vecSize; k += dotLanes) {
+            vaccLo = _mm256_add_pd(vaccLo, _mm256_mul_pd(_mm256_loadu_pd(lhs + k), _mm256_loadu_pd(rhs + k)));
+            vaccHi = _mm256_add_pd(vaccHi, _mm256_mul_pd(_mm256_loadu_pd(lhs + k + 4), _mm256_loadu_pd(rhs + k + 4)));
+        }
+        _mm256_store_pd(acc, vaccLo);
+        _mm256_store_pd(acc + 4, vaccHi);
+#else
+        std::fill_n(acc, dotLanes, Float{0});
+        for (std::size_t k = 0; k < vecSize; k += dotLanes) {
+            for (std::size_t l = 0; l < dotLanes; ++l) {
+                acc[l] += lhs[k + l] * rhs[k + l];
+            }
+        }
+#endif
+        for (std::size_t k = vecSize; k < size; ++k) {
+            acc[k - vecSize] += lhs[k] * rhs[k];
+        }
+
+        Float const sum0 = acc[0] + acc[4];
+        Float const sum1 = acc[1] + acc[5];
+        Float const sum2 = acc[2] + acc[6];
+        Float const sum3 = acc[3] + acc[7];
+        return (sum0 + sum2) + (sum1 + sum3);
+    }
+
+    constexpr std::array<char, 8> binaryMagic{'S', 'P', 'X', 'N', 'N', 'E', 'T', 'B'};
+    constexpr std::uint64_t binaryVersion = 1;
+    // Detects files written on machines with a different byte order
+    constexpr std::uint64_t binaryByteOrderMark = 0x0102030405060708;
+    constexpr std::size_t binaryAlignment = 64;
+
+    struct BinaryHeader {
+        std::array<char, 8> magic;
+        std::uint64_t byteOrderMark;
+        std::uint64_t version;
+        std::uint64_t numLayers;
+        std::uint64_t numInputs;
+        std::uint64_t numOutputs;
+        std::uint64_t maxLayerSize;
+        std::uint64_t reserved;
+    };
+    static_assert(sizeof(BinaryHeader) == binaryAlignment);
+
+    constexpr std::size_t alignedSize(std::size_t size) {
+        return (size + binaryAlignment - 1) / binaryAlignment * binaryAlignment;
+    }
+
+    template<typename T>
+    std::span<T const> readBinaryBlock(MappedFile const & file, std::size_t & offset, std::size_t count) {
+        assert(offset % binaryAlignment == 0);
+        if (offset > file.size() or count > (file.size() - offset) / sizeof(T)) {
+            throw std::logic_error{"Binary model file is truncated"};
+        }
+
+        // The mapping is page-aligned, and so are the blocks within the file
+        auto const * ptr = reinterpret_cast<T const *>(file.data() + offset);
+        offset += alignedSize(count * sizeof(T));
+        return {ptr, count};
+    }
+
+    template<typename T>
+    void writeBinaryBlock(std::ostream & os, std::span<T const> block) {
+        static constexpr std::array<char, binaryAlignment> padding{};
+        std::size_t const size = block.size_bytes();
+        os.write(reinterpret_cast<char const *>(block.data()), size);
+        os.write(padding.data(), alignedSize(size) - size);
+    }
 } // namespace
 
+std::unique_ptr<Network> Network::fromFile(std::string_view filename) {
+    if (isBinaryFile(filename)) { return fromBinaryFile(filename); }
+    return fromNNetFile(filename);
+}
+
 /// Load neural network from .nnet file.
 /// \param filename the path to the .nnet file
 /// \return In-memory representation of the network
@@ -89,13 +186,17 @@ std::unique_ptr<Network> Network::fromNNetFile(std::string_view filename) {
     Biases biases(numLayers);
     for (auto layer = 0u; layer < numLayers - 1; layer++) {
         // Parse weights
+        auto prevLayerSize = layer_sizes.at(layer);
         auto layerSize = layer_sizes.at(layer + 1);
+        weights[layer].reserve(layerSize * prevLayerSize);
         for (auto i = 0u; i < layerSize; i++) {
             std::getline(file, line);
             std::vector<std::string> weightStrings = split(line, ',');
-            weights[layer].emplace_back();
+            if (weightStrings.size() != prevLayerSize) {
+                throw std::logic_error("Unexpected no. weights in model file " + std::string{filename});
+            }
             for (auto const & weightString : weightStrings) {
-                weights[layer][i].push_back(std::stod(weightString));
+                weights[layer].push_back(std::stod(weightString));
             }
         }
 
@@ -109,9 +210,116 @@ std::unique_ptr<Network> Network::fromNNetFile(std::string_view filename) {
     }
     file.close();
 
+    auto parametersPtr = std::make_shared<Parameters>(Parameters{std::move(weights), std::move(biases)});
+    WeightsView weightsView;
+    BiasesView biasesView;
+    for (auto layer = 0u; layer < numLayers - 1; layer++) {
+        weightsView.emplace_back(parametersPtr->weights[layer]);
+        biasesView.emplace_back(parametersPtr->biases[layer]);
+    }
+
     return std::unique_ptr<Network>{new Network(numInputs, numOutputs, numLayers, maxLayerSize,
                                                 std::move(inputMinValues), std::move(inputMaxValues),
-                                                std::move(weights), std::move(biases))};
+                                                std::move(weightsView), std::move(biasesView),
+                                                std::move(parametersPtr))};
+}
+
+/// Load neural network from the binary format written by `writeBinaryFile`.
+/// All the numbers are in the native byte order, each block starts at an offset aligned to 64 bytes:
+/// 1: Header: magic "SPXNNETB", byte order mark, version, number of layers (including the input layer),
+///    number of inputs, number of outputs, maximum layer size, reserved (all as 64-bit unsigned integers)
+/// 2: Layer sizes, from the input layer to the output layer (64-bit unsigned integers)
+/// 3: Minimum values of inputs, maximum values of inputs (each a separate block of doubles)
+/// 4+: For each layer except the input layer, the row-major weight matrix and the bias vector
+///     (each a separate block of doubles)
+std::unique_ptr<Network> Network::fromBinaryFile(std::string_view filename) {
+    auto filePtr = std::make_shared<MappedFile>(filename);
+    auto const & file = *filePtr;
+
+    BinaryHeader header;
+    if (file.size() < sizeof(header)) { throw std::logic_error{"Binary model file is truncated"}; }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != binaryMagic) {
+        throw std::logic_error{"Not a binary model file: " + std::string{filename}};
+    }
+    if (header.byteOrderMark != binaryByteOrderMark) {
+        throw std::logic_error{"Binary model file has incompatible byte order: " + std::string{filename}};
+    }
+    if (header.version != binaryVersion) {
+        throw std::logic_error{"Binary model file has unsupported version: " + std::to_string(header.version)};
+    }
+
+    std::size_t const numLayers = header.numLayers;
+    std::size_t const numInputs = header.numInputs;
+    std::size_t const numOutputs = header.numOutputs;
+    std::size_t const maxLayerSize = header.maxLayerSize;
+    if (numLayers < 2) { throw std::logic_error{"Binary model file has too few layers"}; }
+
+    std::size_t offset = sizeof(header);
+    auto const layerSizes = readBinaryBlock<std::uint64_t>(file, offset, numLayers);
+    if (layerSizes.front() != numInputs or layerSizes.back() != numOutputs) {
+        throw std::logic_error{"Binary model file has inconsistent layer sizes"};
+    }
+
+    auto const inputMinValues = readBinaryBlock<Float>(file, offset, numInputs);
+    auto const inputMaxValues = readBinaryBlock<Float>(file, offset, numInputs);
+
+    WeightsView weightsView;
+    BiasesView biasesView;
+    for (std::size_t layer = 1; layer < numLayers; ++layer) {
+        std::size_t const layerSize = layerSizes[layer];
+        std::size_t const prevLayerSize = layerSizes[layer - 1];
+        if (layerSize > maxLayerSize) { throw std::logic_error{"Binary model file has inconsistent layer sizes"}; }
+        weightsView.push_back(readBinaryBlock<Float>(file, offset, layerSize * prevLayerSize));
+        biasesView.push_back(readBinaryBlock<Float>(file, offset, layerSize));
+    }
+
+    return std::unique_ptr<Network>{new Network(numInputs, numOutputs, numLayers, maxLayerSize,
+                                                Values(inputMinValues.begin(), inputMinValues.end()),
+                                                Values(inputMaxValues.begin(), inputMaxValues.end()),
+                                                std::move(weightsView), std::move(biasesView),
+                                                std::move(filePtr))};
+}
+
+bool Network::isBinaryFile(std::string_view filename) {
+    std::ifstream file{std::string{filename}, std::ios::binary};
+    if (not file.good()) { throw std::ifstream::failure{"Could not open model file " + std::string{filename}}; }
+
+    std::array<char, binaryMagic.size()> magic{};
+    file.read(magic.data(), magic.size());
+    return file.good() and magic == binaryMagic;
+}
+
+void Network::writeBinaryFile(std::string_view filename) const {
+    std::ofstream file{std::string{filename}, std::ios::binary};
+    if (not file.good()) { throw std::ofstream::failure{"Could not open model file " + std::string{filename}}; }
+
+    BinaryHeader const header{.magic = binaryMagic,
+                              .byteOrderMark = binaryByteOrderMark,
+                              .version = binaryVersion,
+                              .numLayers = numLayers,
+                              .numInputs = numInputs,
+                              .numOutputs = numOutputs,
+                              .maxLayerSize = maxLayerSize,
+                              .reserved = 0};
+    file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+
+    std::vector<std::uint64_t> layerSizes;
+    for (std::size_t layer = 0; layer < numLayers; ++layer) {
+        layerSizes.push_back(getLayerSize(layer));
+    }
+    writeBinaryBlock(file, std::span<std::uint64_t const>{layerSizes});
+
+    writeBinaryBlock(file, std::span<Float const>{inputMinimums});
+    writeBinaryBlock(file, std::span<Float const>{inputMaximums});
+
+    for (std::size_t layer = 1; layer < numLayers; ++layer) {
+        writeBinaryBlock(file, weights[layer - 1]);
+        writeBinaryBlock(file, biases[layer - 1]);
+    }
+
+    file.close();
+    if (file.fail()) { throw std::ofstream::failure{"Could not write model file " + std::string{filename}}; }
 }
 
 std::size_t Network::nClasses() const {
@@ -128,10 +336,11 @@ std::size_t Network::getLayerSize(std::size_t layerNum) const {
     return biases[layerNum - 1].size();
 }
 
-Network::Values const & Network::getWeights(std::size_t layerNum, std::size_t nodeIndex) const {
+std::span<Float const> Network::getWeights(std::size_t layerNum, std::size_t nodeIndex) const {
     assert(layerNum > 0);
     assert(nodeIndex < getLayerSize(layerNum));
-    return weights[layerNum - 1][nodeIndex];
+    std::size_t const prevLayerSize = getLayerSize(layerNum - 1);
+    return {weights[layerNum - 1].data() + nodeIndex * prevLayerSize, prevLayerSize};
 }
 
 Float Network::getBias(std::size_t layerNum, std::size_t nodeIndex) const {
@@ -150,36 +359,75 @@ Float Network::getInputUpperBound(std::size_t nodeIndex) const {
     return inputMaximums.at(nodeIndex);
 }
 
-Network::Output Network::operator()(Sample const & sample) const {
+Network::Output Network::operator()(SampleView sample) const {
     Output::Values values = computeOutputValues(sample);
+    return makeOutput(std::move(values));
+}
+
+Network::Outputs Network::computeOutputs(std::span<Float const> samplesValues) const {
+    std::size_t const nVars = nInputs();
+    std::size_t const nOutputs_ = nOutputs();
+    if (samplesValues.size() % nVars != 0) { throw std::logic_error("Input values do not have expected size!"); }
+    std::size_t const size = samplesValues.size() / nVars;
+
+    Outputs outputs;
+    outputs.reserve(size);
+    for (std::size_t first = 0; first < size; first += batchSize) {
+        std::size_t const batchSize_ = std::min(batchSize, size - first);
+        auto const batch = samplesValues.subspan(first * nVars, batchSize_ * nVars);
+        Values const batchValues = computeBatchOutputValues(batch);
+        assert(batchValues.size() == batchSize_ * nOutputs_);
+        for (std::size_t b = 0; b < batchSize_; ++b) {
+            auto const valuesBegin = batchValues.begin() + b * nOutputs_;
+            Output::Values values(valuesBegin, valuesBegin + nOutputs_);
+            outputs.push_back(makeOutput(std::move(values)));
+        }
+    }
+
+    return outputs;
+}
+
+Network::Output Network::makeOutput(Output::Values values) const {
     Classification cls = computeClassification(values);
+    Float margin = computeMargin(values, cls);
+
+    return {.classification = std::move(cls), .values = std::move(values), .margin = margin};
+}
 
-    return {.classification = std::move(cls), .values = std::move(values)};
+Network::Output::Values Network::computeOutputValues(SampleView sample) const {
+    if (sample.size() != nInputs()) { throw std::logic_error("Input values do not have expected size!"); }
+    return computeBatchOutputValues(sample);
 }
 
-Network::Output::Values Network::computeOutputValues(Sample const & sample) const {
+Network::Values Network::computeBatchOutputValues(std::span<Float const> samplesValues) const {
     std::size_t const nVars = nInputs();
-    if (sample.size() != nVars) { throw std::logic_error("Input values do not have expected size!"); }
+    assert(samplesValues.size() % nVars == 0);
+    std::size_t const size = samplesValues.size() / nVars;
+    assert(size <= batchSize);
 
-    auto previousLayerValues = sample;
+    // The input layer is used in place
+    Float const * previousLayerData = samplesValues.data();
+    Values previousLayerValues;
     Values currentLayerValues;
     std::size_t const nLayers_ = nLayers();
     for (std::size_t layer = 1; layer < nLayers_; ++layer) {
         std::size_t const layerSize = getLayerSize(layer);
+        std::size_t const prevLayerSize = getLayerSize(layer - 1);
+        currentLayerValues.resize(size * layerSize);
+        // Each row of weights is reused for all the samples while it is still in the cache
         for (std::size_t node = 0; node < layerSize; ++node) {
-            auto const & incomingWeights = getWeights(layer, node);
-            assert(incomingWeights.size() == previousLayerValues.size());
-            Values addends;
-            for (auto i = 0u; i < incomingWeights.size(); ++i) {
-                addends.push_back(incomingWeights[i] * previousLayerValues[i]);
+            auto const incomingWeights = getWeights(layer, node);
+            Float const bias = getBias(layer, node);
+            for (std::size_t b = 0; b < size; ++b) {
+                Float const * prevValues = previousLayerData + b * prevLayerSize;
+                currentLayerValues[b * layerSize + node] = bias + dot(incomingWeights.data(), prevValues, prevLayerSize);
             }
-            currentLayerValues.push_back(std::accumulate(addends.begin(), addends.end(), getBias(layer, node)));
         }
         if (layer < nLayers_ - 1) {
             std::transform(currentLayerValues.begin(), currentLayerValues.end(), currentLayerValues.begin(),
                            [](Float val) { return std::max(Float{0}, val); });
-            previousLayerValues = std::move(currentLayerValues);
-            currentLayerValues.clear();
+            std::swap(previousLayerValues, currentLayerValues);
+            previousLayerData = previousLayerValues.data();
         }
     }
     return currentLayerValues;
@@ -212,7 +460,31 @@ Network::Classification Network::computeNonBinaryClassification(Output::Values c
     return {.label = label};
 }
 
+Float Network::computeMargin(Output::Values const & values, Classification const & cls) const {
+    assert(nClasses() >= 2);
+    if (nClasses() == 2) {
+        assert(values.size() == 1);
+        return std::abs(values.front());
+    }
+
+    auto const & label = cls.label;
+    assert(label < values.size());
+    Float const labelValue = values[label];
+    Float maxOtherValue = std::numeric_limits<Float>::lowest();
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i == label) { continue; }
+        maxOtherValue = std::max(maxOtherValue, values[i]);
+    }
+
+    assert(labelValue >= maxOtherValue);
+    return labelValue - maxOtherValue;
+}
+
 void Network::Values::print(std::ostream & os) const {
+    ValuesView{*this}.print(os);
+}
+
+void Network::ValuesView::print(std::ostream & os) const {
     assert(not empty());
     os << front();
     for (Float val : *this | std::views::drop(1)) {
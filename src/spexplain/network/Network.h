@@ -4,6 +4,7 @@
 #include <spexplain/common/Core.h>
 
 #include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -18,6 +19,15 @@ public:
         void print(std::ostream &) const;
     };
 
+    // Non-owning view of values, e.g. within a larger contiguous buffer
+    struct ValuesView : std::span<Float const> {
+        using Idx = size_type;
+
+        using span::span;
+
+        void print(std::ostream &) const;
+    };
+
     struct Classification {
         using Label = std::size_t;
 
@@ -27,17 +37,31 @@ public:
     using Classifications = std::vector<Classification>;
 
     using Sample = Values;
+    using SampleView = ValuesView;
 
     struct Output {
         using Values = Network::Values;
 
         Classification classification;
         Values values{};
+        // Distance of the output values from changing the classification
+        Float margin{};
     };
 
+    using Outputs = std::vector<Output>;
+
     class Dataset;
+    class BoundPropagation;
 
+    // Detects the format from the contents of the file
+    static std::unique_ptr<Network> fromFile(std::string_view filename);
     static std::unique_ptr<Network> fromNNetFile(std::string_view filename);
+    // The file is memory-mapped and the parameters are used in place
+    static std::unique_ptr<Network> fromBinaryFile(std::string_view filename);
+
+    static bool isBinaryFile(std::string_view filename);
+
+    void writeBinaryFile(std::string_view filename) const;
 
     std::size_t nInputs() const { return numInputs; }
     std::size_t nOutputs() const { return numOutputs; }
@@ -47,28 +71,53 @@ public:
 
     std::size_t getLayerSize(std::size_t layerNum) const;
 
-    Values const & getWeights(std::size_t layerNum, std::size_t nodeIndex) const;
+    // Incoming weights of the node
+    std::span<Float const> getWeights(std::size_t layerNum, std::size_t nodeIndex) const;
 
     Float getBias(std::size_t layerNum, std::size_t nodeIndex) const;
 
     Float getInputLowerBound(std::size_t node) const;
     Float getInputUpperBound(std::size_t node) const;
 
-    Output operator()(Sample const &) const;
+    // The results of the batched and the single-sample computation are identical,
+    // the summation is not sequential though, which may differ from it by (n+1)*eps*sum(|w*x|) per neuron
+    Output operator()(SampleView) const;
+    // Row-major matrix of the values of the samples
+    Outputs computeOutputs(std::span<Float const> samplesValues) const;
 
 protected:
-    Output::Values computeOutputValues(Sample const &) const;
+    // Maximal no. samples evaluated at once
+    static constexpr std::size_t batchSize = 16;
+
+    Output::Values computeOutputValues(SampleView) const;
+    // Row-major matrices of the values of the samples and of the output values, at most `batchSize` samples
+    Values computeBatchOutputValues(std::span<Float const> samplesValues) const;
+
+    Output makeOutput(Output::Values) const;
 
     Classification computeClassification(Output::Values const &) const;
     Classification computeBinaryClassification(Output::Values const &) const;
     Classification computeNonBinaryClassification(Output::Values const &) const;
 
+    Float computeMargin(Output::Values const &, Classification const &) const;
+
 private:
-    using Weights = std::vector<std::vector<Values>>;
+    // Per layer, row-major matrix with the incoming weights of each node
+    using Weights = std::vector<Values>;
     using Biases = std::vector<Values>;
 
+    // Per layer except the input layer, the memory is owned by the storage
+    using WeightsView = std::vector<std::span<Float const>>;
+    using BiasesView = std::vector<std::span<Float const>>;
+
+    struct Parameters {
+        Weights weights;
+        Biases biases;
+    };
+
     Network(std::size_t numInputs_, std::size_t numOutputs_, std::size_t numLayers_, std::size_t maxLayerSize_,
-            Values inputMinimums_, Values inputMaximums_, Weights weights_, Biases biases_)
+            Values inputMinimums_, Values inputMaximums_, WeightsView weights_, BiasesView biases_,
+            std::shared_ptr<void const> storage_)
         : numInputs{numInputs_},
           numOutputs{numOutputs_},
           numLayers{numLayers_},
@@ -76,7 +125,8 @@ private:
           inputMinimums{std::move(inputMinimums_)},
           inputMaximums{std::move(inputMaximums_)},
           weights{std::move(weights_)},
-          biases{std::move(biases_)} {}
+          biases{std::move(biases_)},
+          storage{std::move(storage_)} {}
 
     std::size_t numInputs;
     std::size_t numOutputs;
@@ -84,8 +134,10 @@ private:
     std::size_t maxLayerSize;
     Values inputMinimums;
     Values inputMaximums;
-    Weights weights;
-    Biases biases;
+    WeightsView weights;
+    BiasesView biases;
+    // Either the parsed parameters or the mapped file
+    std::shared_ptr<void const> storage;
 };
 } // namespace spexplain
 
@@ -0,0 +1,74 @@
+#include <spexplain/network/Network.h>
+
+#include <verifiers/marabou/MarabouVerifier.h>
+
+#include <iostream>
+#include <string>
+
+#ifndef SPEXPLAIN_DATA_DIR
+#define SPEXPLAIN_DATA_DIR "data"
+#endif
+
+namespace {
+using xai::verifiers::MarabouVerifier;
+using Answer = xai::verifiers::Verifier::Answer;
+
+char const * toString(Answer answer) {
+    switch (answer) {
+        case Answer::SAT:
+            return "SAT";
+        case Answer::UNSAT:
+            return "UNSAT";
+        case Answer::UNKNOWN:
+            return "UNKNOWN";
+        case Answer::ERROR:
+            return "ERROR";
+    }
+    return "?";
+}
+
+bool expect(char const * what, Answer answer, Answer expected) {
+    if (answer == expected) { return true; }
+    std::cerr << what << ": expected " << toString(expected) << ", got " << toString(answer) << std::endl;
+    return false;
+}
+} // namespace
+
+// The checks of the same verifier must not affect each other,
+// in particular a tight box must not leave the phases of the ReLUs fixed for a looser box
+int main() {
+    using spexplain::Network;
+
+    auto const networkPtr = Network::fromNNetFile(std::string{SPEXPLAIN_DATA_DIR} + "/models/toy.nnet");
+    auto const & network = *networkPtr;
+    auto const outputLayerIndex = network.nLayers() - 1;
+
+    MarabouVerifier verifier;
+    verifier.init();
+
+    bool ok = true;
+    // The model is loaded for each sample
+    for (int sample = 0; sample < 2; ++sample) {
+        verifier.loadModel(network);
+
+        // y = relu(2*x0 + x2) - 4*relu(-x0 + x1 - x2), hence y = 8 within the point (4, 0, 0)
+        verifier.push();
+        verifier.addLowerBound(outputLayerIndex, 0, 0);
+        verifier.addUpperBound(outputLayerIndex, 0, 7);
+
+        verifier.push();
+        verifier.addLowerBound(0, 0, 4);
+        verifier.addUpperBound(0, 1, 0);
+        verifier.addUpperBound(0, 2, 0);
+        ok &= expect("tight box", verifier.check(), Answer::UNSAT);
+        verifier.pop();
+
+        // E.g. y = 0 within the point (0, 0, 0)
+        ok &= expect("loose box", verifier.check(), Answer::SAT);
+        verifier.pop();
+
+        verifier.reset();
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include "BoundPropagationVerifier.h"
+
+#include <cassert>
+#include <limits>
+
+namespace xai::verifiers {
+
+BoundPropagationVerifier::BoundPropagationVerifier(std::unique_ptr<Verifier> vf,
+                                                   spexplain::Network::BoundPropagation::Type tp)
+    : verifierPtr{std::move(vf)},
+      boundPropagationType{tp} {
+    assert(verifierPtr);
+}
+
+void BoundPropagationVerifier::loadModel(spexplain::Network const & network) {
+    verifierPtr->loadModel(network);
+
+    if (not boundPropagationPtr or &boundPropagationPtr->getNetwork() != &network) {
+        boundPropagationPtr = std::make_unique<spexplain::Network::BoundPropagation>(network, boundPropagationType);
+    }
+
+    inputBox.reset(network);
+    outputBounds.clear();
+    classificationConstraints.clear();
+    levels.clear();
+}
+
+void BoundPropagationVerifier::addUpperBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm) {
+    verifierPtr->addUpperBound(layer, var, value, explanationTerm);
+    addBound(layer, var, std::numeric_limits<Float>::lowest(), value);
+}
+
+void BoundPropagationVerifier::addLowerBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm) {
+    verifierPtr->addLowerBound(layer, var, value, explanationTerm);
+    addBound(layer, var, value, std::numeric_limits<Float>::max());
+}
+
+void BoundPropagationVerifier::addEquality(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm) {
+    verifierPtr->addEquality(layer, var, value, explanationTerm);
+    addBound(layer, var, value, value);
+}
+
+void BoundPropagationVerifier::addInterval(LayerIndex layer, NodeIndex var, Float lo, Float hi,
+                                           bool explanationTerm) {
+    verifierPtr->addInterval(layer, var, lo, hi, explanationTerm);
+    addBound(layer, var, lo, hi);
+}
+
+void BoundPropagationVerifier::addBound(LayerIndex layer, NodeIndex var, Float lo, Float hi) {
+    assert(boundPropagationPtr);
+    auto const & network = boundPropagationPtr->getNetwork();
+
+    if (layer == 0) {
+        inputBox.tightenInterval(var, lo, hi);
+        return;
+    }
+
+    // Bounds of the hidden neurons are just ignored, which is sound
+    if (layer != network.nLayers() - 1) { return; }
+
+    outputBounds.push_back({var, lo, hi});
+}
+
+void BoundPropagationVerifier::addGuardedBoundImpl([[maybe_unused]] Guard guard, GuardedBound const & bnd) {
+    // The guards of the decorated verifier follow the same push/pop scopes, hence they coincide
+    [[maybe_unused]] Guard const innerGuard = verifierPtr->addGuardedInterval(bnd.layer, bnd.var, bnd.lo, bnd.hi);
+    assert(innerGuard == guard);
+}
+
+void BoundPropagationVerifier::addClassificationConstraint(NodeIndex node, Float threshold) {
+    verifierPtr->addClassificationConstraint(node, threshold);
+    classificationConstraints.push_back({node, threshold});
+}
+
+void BoundPropagationVerifier::addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) {
+    verifierPtr->addOutputDifferenceConstraint(node, otherNode, threshold);
+    classificationConstraints.push_back({node, threshold, otherNode});
+}
+
+void BoundPropagationVerifier::addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs,
+                                             Float rhs) {
+    // Additional constraints can only make the query less satisfiable, so they are ignored here
+    verifierPtr->addConstraint(layer, std::move(lhs), rhs);
+}
+
+void BoundPropagationVerifier::init() {
+    // The decorated verifier also resets itself
+    verifierPtr->init();
+    checksCount = 0;
+    fastChecksCount = 0;
+    resetGuardedBounds();
+}
+
+void BoundPropagationVerifier::pushImpl() {
+    verifierPtr->push();
+
+    inputBox.push();
+    levels.push_back({outputBounds.size(), classificationConstraints.size()});
+}
+
+void BoundPropagationVerifier::popImpl() {
+    verifierPtr->pop();
+
+    inputBox.pop();
+    assert(not levels.empty());
+    auto const [outputBoundsSize, classificationConstraintsSize] = levels.back();
+    levels.pop_back();
+    outputBounds.resize(outputBoundsSize);
+    classificationConstraints.resize(classificationConstraintsSize);
+}
+
+void BoundPropagationVerifier::setTimeLimit(std::chrono::milliseconds limit) {
+    verifierPtr->setTimeLimit(limit);
+}
+
+Verifier::Answer BoundPropagationVerifier::checkImpl() {
+    if (provesUnsat()) {
+        ++fastChecksCount;
+        return Answer::UNSAT;
+    }
+
+    return verifierPtr->check();
+}
+
+Verifier::Answer BoundPropagationVerifier::checkAssumingImpl(std::span<Guard const> guards) {
+    inputBox.push();
+    std::size_t const outputBoundsSize = outputBounds.size();
+    for (Guard guard : guards) {
+        auto const & [layer, var, lo, hi] = getGuardedBound(guard);
+        addBound(layer, var, lo, hi);
+    }
+
+    bool const proven = provesUnsat();
+
+    inputBox.pop();
+    outputBounds.resize(outputBoundsSize);
+
+    if (proven) {
+        ++fastChecksCount;
+        return Answer::UNSAT;
+    }
+
+    return verifierPtr->checkAssuming(guards);
+}
+
+bool BoundPropagationVerifier::provesUnsat() {
+    if (inputBox.isEmpty()) { return true; }
+    if (outputBounds.empty() and classificationConstraints.empty()) { return false; }
+
+    auto & boundPropagation = *boundPropagationPtr;
+    boundPropagation(inputBox.getLowerBounds(), inputBox.getUpperBounds());
+
+    auto const & network = boundPropagation.getNetwork();
+    LayerIndex const outputLayer = network.nLayers() - 1;
+
+    for (auto const & [node, lo, hi] : outputBounds) {
+        if (boundPropagation.getLowerBound(outputLayer, node) > hi) { return true; }
+        if (boundPropagation.getUpperBound(outputLayer, node) < lo) { return true; }
+    }
+
+    // The constraint requires that `output[i] - output[node] > threshold` for some other output `i`
+    std::size_t const nOutputs = network.nOutputs();
+    for (auto const & [node, threshold, otherNode] : classificationConstraints) {
+        bool provenForAll = true;
+        for (NodeIndex i = 0; i < nOutputs; ++i) {
+            if (i == node) { continue; }
+            if (otherNode != ClassificationConstraint::anyNode and i != otherNode) { continue; }
+            if (boundPropagation.getOutputDifferenceLowerBound(node, i) > -threshold) { continue; }
+            provenForAll = false;
+            break;
+        }
+        if (provenForAll) { return true; }
+    }
+
+    return false;
+}
+
+void BoundPropagationVerifier::resetSampleQuery() {
+    verifierPtr->resetSampleQuery();
+}
+
+void BoundPropagationVerifier::resetSample() {
+    // The decorated verifier also resets the query
+    verifierPtr->resetSample();
+    checksCount = 0;
+    fastChecksCount = 0;
+    resetGuardedBounds();
+}
+
+void BoundPropagationVerifier::reset() {
+    // The decorated verifier also resets the sample
+    verifierPtr->reset();
+    checksCount = 0;
+    fastChecksCount = 0;
+    resetGuardedBounds();
+}
+
+void BoundPropagationVerifier::printSmtLib2Query(std::ostream & os) const {
+    verifierPtr->printSmtLib2Query(os);
+}
+} // namespace xai::verifiers
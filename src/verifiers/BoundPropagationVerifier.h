@@ -0,0 +1,97 @@
+#ifndef XAI_SMT_BOUNDPROPAGATIONVERIFIER_H
+#define XAI_SMT_BOUNDPROPAGATIONVERIFIER_H
+
+#include "InputBox.h"
+#include "Verifier.h"
+
+#include <spexplain/network/BoundPropagation.h>
+
+#include <limits>
+#include <memory>
+
+namespace xai::verifiers {
+
+// Decorates another verifier: first tries to prove the query unsatisfiable by bound propagation
+// over the asserted box of the inputs, and only if inconclusive, runs the decorated verifier
+// Must not be used if the caller queries the state of the decorated verifier after a check (e.g. unsat cores)
+class BoundPropagationVerifier : public Verifier {
+public:
+    BoundPropagationVerifier(std::unique_ptr<Verifier>, spexplain::Network::BoundPropagation::Type);
+
+    Verifier const & getInnerVerifier() const { return *verifierPtr; }
+    Verifier & getInnerVerifier() { return *verifierPtr; }
+
+    void loadModel(spexplain::Network const &) override;
+
+    void addUpperBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm = false) override;
+    void addLowerBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm = false) override;
+    void addEquality(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm = false) override;
+    void addInterval(LayerIndex layer, NodeIndex var, Float lo, Float hi, bool explanationTerm = false) override;
+
+    void addClassificationConstraint(NodeIndex node, Float threshold) override;
+    void addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) override;
+
+    void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) override;
+
+    void init() override;
+
+    void setTimeLimit(std::chrono::milliseconds) override;
+
+    // No. checks settled without the decorated verifier
+    std::size_t getFastChecksCount() const { return fastChecksCount; }
+
+    void resetSampleQuery() override;
+    void resetSample() override;
+    void reset() override;
+
+    void printSmtLib2Query(std::ostream &) const override;
+
+protected:
+    struct OutputBound {
+        NodeIndex node;
+        Float lo;
+        Float hi;
+    };
+
+    struct ClassificationConstraint {
+        static constexpr NodeIndex anyNode = std::numeric_limits<NodeIndex>::max();
+
+        NodeIndex node;
+        Float threshold;
+        // Just a particular disjunct if set
+        NodeIndex otherNode{anyNode};
+    };
+
+    struct Level {
+        std::size_t outputBoundsSize;
+        std::size_t classificationConstraintsSize;
+    };
+
+    void addBound(LayerIndex layer, NodeIndex var, Float lo, Float hi);
+
+    bool provesUnsat();
+
+    std::unique_ptr<Verifier> verifierPtr;
+
+    spexplain::Network::BoundPropagation::Type boundPropagationType;
+    std::unique_ptr<spexplain::Network::BoundPropagation> boundPropagationPtr{};
+
+    InputBox inputBox{};
+    std::vector<OutputBound> outputBounds{};
+    std::vector<ClassificationConstraint> classificationConstraints{};
+    std::vector<Level> levels{};
+
+    std::size_t fastChecksCount{};
+
+private:
+    void pushImpl() override;
+    void popImpl() override;
+
+    Answer checkImpl() override;
+
+    void addGuardedBoundImpl(Guard, GuardedBound const &) override;
+    Answer checkAssumingImpl(std::span<Guard const>) override;
+};
+} // namespace xai::verifiers
+
+#endif // XAI_SMT_BOUNDPROPAGATIONVERIFIER_H
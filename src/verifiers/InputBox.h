@@ -0,0 +1,91 @@
+#ifndef XAI_SMT_INPUTBOX_H
+#define XAI_SMT_INPUTBOX_H
+
+#include "Verifier.h"
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <vector>
+
+namespace xai::verifiers {
+
+// Tracks the box of the inputs implied by the asserted bounds, following the push/pop scopes of the verifier
+class InputBox {
+public:
+    // Starts over with the domains of the inputs
+    void reset(spexplain::Network const & network) {
+        std::size_t const size = network.nInputs();
+        lowerBounds.resize(size);
+        upperBounds.resize(size);
+        for (NodeIndex node = 0; node < size; ++node) {
+            lowerBounds[node] = network.getInputLowerBound(node);
+            upperBounds[node] = network.getInputUpperBound(node);
+        }
+
+        trail.clear();
+        levels.clear();
+        empty = false;
+    }
+
+    std::size_t size() const { return lowerBounds.size(); }
+
+    std::span<Float const> getLowerBounds() const { return lowerBounds; }
+    std::span<Float const> getUpperBounds() const { return upperBounds; }
+
+    bool isEmpty() const { return empty; }
+
+    void tightenLowerBound(NodeIndex node, Float value) { tightenInterval(node, value, upperBounds[node]); }
+    void tightenUpperBound(NodeIndex node, Float value) { tightenInterval(node, lowerBounds[node], value); }
+    void tightenInterval(NodeIndex node, Float lo, Float hi) {
+        assert(node < size());
+        Float & lower = lowerBounds[node];
+        Float & upper = upperBounds[node];
+        if (lo <= lower and hi >= upper) { return; }
+
+        trail.push_back({node, lower, upper});
+        lower = std::max(lower, lo);
+        upper = std::min(upper, hi);
+        if (lower > upper) { empty = true; }
+    }
+
+    std::size_t getLevel() const { return levels.size(); }
+
+    void push() { levels.push_back({trail.size(), empty}); }
+    void pop() {
+        assert(not levels.empty());
+        auto const [trailSize, wasEmpty] = levels.back();
+        levels.pop_back();
+
+        while (trail.size() > trailSize) {
+            auto const & [node, lower, upper] = trail.back();
+            lowerBounds[node] = lower;
+            upperBounds[node] = upper;
+            trail.pop_back();
+        }
+        empty = wasEmpty;
+    }
+
+protected:
+    struct TrailEntry {
+        NodeIndex node;
+        Float lower;
+        Float upper;
+    };
+
+    struct Level {
+        std::size_t trailSize;
+        bool empty;
+    };
+
+    std::vector<Float> lowerBounds{};
+    std::vector<Float> upperBounds{};
+
+    std::vector<TrailEntry> trail{};
+    std::vector<Level> levels{};
+
+    bool empty{};
+};
+} // namespace xai::verifiers
+
+#endif // XAI_SMT_INPUTBOX_H
@@ -0,0 +1,293 @@
+#include "SplitClassificationVerifier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <limits>
+#include <mutex>
+
+namespace xai::verifiers {
+
+namespace {
+// The least conclusive answer wins, except that a single SAT suffices
+Verifier::Answer mergeAnswers(Verifier::Answer acc, Verifier::Answer answer) {
+    using Answer = Verifier::Answer;
+    if (acc == Answer::SAT or answer == Answer::SAT) { return Answer::SAT; }
+    if (acc == Answer::ERROR or answer == Answer::ERROR) { return Answer::ERROR; }
+    if (acc == Answer::UNKNOWN or answer == Answer::UNKNOWN) { return Answer::UNKNOWN; }
+    return Answer::UNSAT;
+}
+} // namespace
+
+SplitClassificationVerifier::SplitClassificationVerifier(std::vector<std::unique_ptr<Verifier>> vfs,
+                                                         spexplain::Network::BoundPropagation::Type tp)
+    : verifierPtrs{std::move(vfs)},
+      boundPropagationType{tp} {
+    assert(not verifierPtrs.empty());
+    assert(std::ranges::all_of(verifierPtrs, [](auto & vfPtr) { return bool(vfPtr); }));
+
+    // The threads persist across the checks
+    if (verifierPtrs.size() > 1) { threadPoolPtr = std::make_unique<spexplain::ThreadPool>(verifierPtrs.size()); }
+}
+
+void SplitClassificationVerifier::loadModel(spexplain::Network const & network) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->loadModel(network);
+    }
+
+    if (not boundPropagationPtr or &boundPropagationPtr->getNetwork() != &network) {
+        boundPropagationPtr = std::make_unique<spexplain::Network::BoundPropagation>(network, boundPropagationType);
+    }
+
+    inputBox.reset(network);
+    classificationConstraints.clear();
+    classificationConstraintsLimits.clear();
+}
+
+void SplitClassificationVerifier::addUpperBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->addUpperBound(layer, var, value, explanationTerm);
+    }
+    addInputBound(layer, var, std::numeric_limits<Float>::lowest(), value);
+}
+
+void SplitClassificationVerifier::addLowerBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->addLowerBound(layer, var, value, explanationTerm);
+    }
+    addInputBound(layer, var, value, std::numeric_limits<Float>::max());
+}
+
+void SplitClassificationVerifier::addEquality(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->addEquality(layer, var, value, explanationTerm);
+    }
+    addInputBound(layer, var, value, value);
+}
+
+void SplitClassificationVerifier::addInterval(LayerIndex layer, NodeIndex var, Float lo, Float hi,
+                                              bool explanationTerm) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->addInterval(layer, var, lo, hi, explanationTerm);
+    }
+    addInputBound(layer, var, lo, hi);
+}
+
+void SplitClassificationVerifier::addInputBound(LayerIndex layer, NodeIndex var, Float lo, Float hi) {
+    // Bounds of the other neurons are just ignored in the pruning, which is sound
+    if (layer != 0) { return; }
+
+    inputBox.tightenInterval(var, lo, hi);
+}
+
+void SplitClassificationVerifier::addGuardedBoundImpl([[maybe_unused]] Guard guard, GuardedBound const & bnd) {
+    // The guards of the decorated verifiers follow the same push/pop scopes, hence they coincide
+    for (auto & vfPtr : verifierPtrs) {
+        [[maybe_unused]] Guard const innerGuard = vfPtr->addGuardedInterval(bnd.layer, bnd.var, bnd.lo, bnd.hi);
+        assert(innerGuard == guard);
+    }
+}
+
+void SplitClassificationVerifier::addClassificationConstraint(NodeIndex node, Float threshold) {
+    // Asserted to the decorated verifiers only within the particular checks
+    classificationConstraints.push_back({node, threshold});
+}
+
+void SplitClassificationVerifier::addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs,
+                                                Float rhs) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->addConstraint(layer, lhs, rhs);
+    }
+}
+
+void SplitClassificationVerifier::init() {
+    // The decorated verifiers also reset themselves
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->init();
+    }
+    checksCount = 0;
+    skippedOutputsCount = 0;
+    resetGuardedBounds();
+}
+
+void SplitClassificationVerifier::pushImpl() {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->push();
+    }
+
+    inputBox.push();
+    classificationConstraintsLimits.push_back(classificationConstraints.size());
+}
+
+void SplitClassificationVerifier::popImpl() {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->pop();
+    }
+
+    inputBox.pop();
+    assert(not classificationConstraintsLimits.empty());
+    classificationConstraints.resize(classificationConstraintsLimits.back());
+    classificationConstraintsLimits.pop_back();
+}
+
+void SplitClassificationVerifier::setTimeLimit(std::chrono::milliseconds limit) {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->setTimeLimit(limit);
+    }
+}
+
+Verifier::Answer SplitClassificationVerifier::checkImpl() {
+    if (inputBox.isEmpty()) { return Answer::UNSAT; }
+    if (classificationConstraints.empty()) { return verifierPtrs.front()->check(); }
+
+    auto const competingOutputs = computeCompetingOutputs();
+    return checkCompetingOutputs(competingOutputs, {}, false);
+}
+
+Verifier::Answer SplitClassificationVerifier::checkAssumingImpl(std::span<Guard const> guards) {
+    if (classificationConstraints.empty()) { return verifierPtrs.front()->checkAssuming(guards); }
+
+    inputBox.push();
+    for (Guard guard : guards) {
+        auto const & [layer, var, lo, hi] = getGuardedBound(guard);
+        addInputBound(layer, var, lo, hi);
+    }
+
+    bool const empty = inputBox.isEmpty();
+    std::vector<NodeIndex> competingOutputs;
+    if (not empty) { competingOutputs = computeCompetingOutputs(); }
+
+    inputBox.pop();
+
+    if (empty) { return Answer::UNSAT; }
+
+    return checkCompetingOutputs(competingOutputs, guards, true);
+}
+
+std::vector<NodeIndex> SplitClassificationVerifier::computeCompetingOutputs() {
+    assert(not classificationConstraints.empty());
+    assert(not inputBox.isEmpty());
+
+    auto & boundPropagation = *boundPropagationPtr;
+    boundPropagation(inputBox.getLowerBounds(), inputBox.getUpperBounds());
+
+    auto const & network = boundPropagation.getNetwork();
+    std::size_t const nOutputs = network.nOutputs();
+
+    auto const & [node, threshold] = classificationConstraints.front();
+
+    // The constraint requires that `output[i] - output[node] > threshold`
+    std::vector<std::pair<Float, NodeIndex>> competing;
+    for (NodeIndex i = 0; i < nOutputs; ++i) {
+        if (i == node) { continue; }
+        Float const diffLowerBound = boundPropagation.getOutputDifferenceLowerBound(node, i);
+        if (diffLowerBound > -threshold) {
+            ++skippedOutputsCount;
+            continue;
+        }
+        competing.emplace_back(diffLowerBound, i);
+    }
+
+    // The smaller the guaranteed margin of the classified output, the more likely the competing output wins
+    std::ranges::sort(competing);
+
+    std::vector<NodeIndex> competingOutputs;
+    competingOutputs.reserve(competing.size());
+    for (auto const & [_, i] : competing) {
+        competingOutputs.push_back(i);
+    }
+    return competingOutputs;
+}
+
+Verifier::Answer SplitClassificationVerifier::checkCompetingOutputs(std::span<NodeIndex const> competingOutputs,
+                                                                    std::span<Guard const> guards, bool assuming) {
+    std::size_t const size = competingOutputs.size();
+    std::size_t const nWorkers = std::min(verifierPtrs.size(), size);
+
+    if (nWorkers <= 1) {
+        Answer answer = Answer::UNSAT;
+        for (NodeIndex i : competingOutputs) {
+            answer = mergeAnswers(answer, checkCompetingOutput(*verifierPtrs.front(), i, guards, assuming));
+            if (answer == Answer::SAT) { break; }
+        }
+        return answer;
+    }
+
+    std::atomic<std::size_t> nextPos{0};
+    std::atomic<bool> found{false};
+    std::mutex mtx;
+    Answer answer = Answer::UNSAT;
+    std::exception_ptr exceptionPtr{};
+
+    auto work = [&](std::size_t workerIdx) {
+        auto & verifier = *verifierPtrs[workerIdx];
+        try {
+            std::size_t pos;
+            while (not found and (pos = nextPos++) < size) {
+                Answer const ans = checkCompetingOutput(verifier, competingOutputs[pos], guards, assuming);
+                if (ans == Answer::SAT) { found = true; }
+                std::lock_guard lock{mtx};
+                answer = mergeAnswers(answer, ans);
+            }
+        } catch (...) {
+            found = true;
+            std::lock_guard lock{mtx};
+            if (not exceptionPtr) { exceptionPtr = std::current_exception(); }
+        }
+    };
+
+    threadPoolPtr->run(nWorkers, work);
+
+    if (exceptionPtr) { std::rethrow_exception(exceptionPtr); }
+
+    return answer;
+}
+
+Verifier::Answer SplitClassificationVerifier::checkCompetingOutput(Verifier & verifier, NodeIndex i,
+                                                                   std::span<Guard const> guards, bool assuming) {
+    auto const & [node, threshold] = classificationConstraints.front();
+
+    verifier.push();
+    verifier.addOutputDifferenceConstraint(node, i, threshold);
+    // Any further classification constraints are kept as they are
+    for (auto const & [otherNode, otherThreshold] : std::span{classificationConstraints}.subspan(1)) {
+        verifier.addClassificationConstraint(otherNode, otherThreshold);
+    }
+    Answer const answer = assuming ? verifier.checkAssuming(guards) : verifier.check();
+    verifier.pop();
+
+    return answer;
+}
+
+void SplitClassificationVerifier::resetSampleQuery() {
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->resetSampleQuery();
+    }
+}
+
+void SplitClassificationVerifier::resetSample() {
+    // The decorated verifiers also reset the query
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->resetSample();
+    }
+    checksCount = 0;
+    skippedOutputsCount = 0;
+    resetGuardedBounds();
+}
+
+void SplitClassificationVerifier::reset() {
+    // The decorated verifiers also reset the sample
+    for (auto & vfPtr : verifierPtrs) {
+        vfPtr->reset();
+    }
+    checksCount = 0;
+    skippedOutputsCount = 0;
+    resetGuardedBounds();
+}
+
+void SplitClassificationVerifier::printSmtLib2Query(std::ostream & os) const {
+    // Without the classification constraints
+    verifierPtrs.front()->printSmtLib2Query(os);
+}
+} // namespace xai::verifiers
@@ -0,0 +1,90 @@
+#ifndef XAI_SMT_SPLITCLASSIFICATIONVERIFIER_H
+#define XAI_SMT_SPLITCLASSIFICATIONVERIFIER_H
+
+#include "InputBox.h"
+#include "Verifier.h"
+
+#include <spexplain/common/ThreadPool.h>
+#include <spexplain/network/BoundPropagation.h>
+
+#include <memory>
+#include <vector>
+
+namespace xai::verifiers {
+
+// Decorates other verifiers: instead of the disjunction of the classification constraint over all the other outputs,
+// checks each competing output as a separate conjunctive query, skipping the outputs that bound propagation
+// over the asserted box of the inputs proves to never beat the classified one
+// All the decorated verifiers receive the same assertions, and if there are more of them,
+// the competing outputs are checked in parallel
+// Must not be used if the caller queries the state of the decorated verifiers after a check (e.g. unsat cores)
+class SplitClassificationVerifier : public Verifier {
+public:
+    SplitClassificationVerifier(std::vector<std::unique_ptr<Verifier>>, spexplain::Network::BoundPropagation::Type);
+
+    std::size_t nInnerVerifiers() const { return verifierPtrs.size(); }
+    Verifier const & getInnerVerifier(std::size_t idx) const { return *verifierPtrs[idx]; }
+    Verifier & getInnerVerifier(std::size_t idx) { return *verifierPtrs[idx]; }
+
+    void loadModel(spexplain::Network const &) override;
+
+    void addUpperBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm = false) override;
+    void addLowerBound(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm = false) override;
+    void addEquality(LayerIndex layer, NodeIndex var, Float value, bool explanationTerm = false) override;
+    void addInterval(LayerIndex layer, NodeIndex var, Float lo, Float hi, bool explanationTerm = false) override;
+
+    void addClassificationConstraint(NodeIndex node, Float threshold) override;
+
+    void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) override;
+
+    void init() override;
+
+    void setTimeLimit(std::chrono::milliseconds) override;
+
+    // No. competing outputs that did not have to be checked
+    std::size_t getSkippedOutputsCount() const { return skippedOutputsCount; }
+
+    void resetSampleQuery() override;
+    void resetSample() override;
+    void reset() override;
+
+    void printSmtLib2Query(std::ostream &) const override;
+
+protected:
+    struct ClassificationConstraint {
+        NodeIndex node;
+        Float threshold;
+    };
+
+    void addInputBound(LayerIndex layer, NodeIndex var, Float lo, Float hi);
+
+    // The competing outputs of the first classification constraint that are not ruled out, most promising first
+    std::vector<NodeIndex> computeCompetingOutputs();
+
+    Answer checkCompetingOutputs(std::span<NodeIndex const>, std::span<Guard const> guards, bool assuming);
+    Answer checkCompetingOutput(Verifier &, NodeIndex, std::span<Guard const> guards, bool assuming);
+
+    std::vector<std::unique_ptr<Verifier>> verifierPtrs;
+    std::unique_ptr<spexplain::ThreadPool> threadPoolPtr{};
+
+    std::unique_ptr<spexplain::Network::BoundPropagation> boundPropagationPtr{};
+    spexplain::Network::BoundPropagation::Type boundPropagationType;
+
+    InputBox inputBox{};
+    std::vector<ClassificationConstraint> classificationConstraints{};
+    std::vector<std::size_t> classificationConstraintsLimits{};
+
+    std::size_t skippedOutputsCount{};
+
+private:
+    void pushImpl() override;
+    void popImpl() override;
+
+    Answer checkImpl() override;
+
+    void addGuardedBoundImpl(Guard, GuardedBound const &) override;
+    Answer checkAssumingImpl(std::span<Guard const>) override;
+};
+} // namespace xai::verifiers
+
+#endif // XAI_SMT_SPLITCLASSIFICATIONVERIFIER_H
@@ -4,6 +4,9 @@
 #include <spexplain/network/Network.h>
 
 #include <chrono>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -19,6 +22,19 @@ class Verifier {
 public:
     enum class Answer { SAT, UNSAT, UNKNOWN, ERROR };
 
+    // Handle of a guarded bound, which only holds within the checks that assume it
+    using Guard = std::size_t;
+
+    struct GuardedBound {
+        static constexpr Float unboundedLower = std::numeric_limits<Float>::lowest();
+        static constexpr Float unboundedUpper = std::numeric_limits<Float>::max();
+
+        LayerIndex layer;
+        NodeIndex var;
+        Float lo{unboundedLower};
+        Float hi{unboundedUpper};
+    };
+
     Verifier() = default;
     virtual ~Verifier() = default;
     Verifier(Verifier const &) = delete;
@@ -38,7 +54,28 @@ public:
         addLowerBound(layer, var, lo, explanationTerm);
     }
 
+    // The guarded bounds are asserted just once and are kept until the current level is popped
+    Guard addGuardedUpperBound(LayerIndex layer, NodeIndex var, Float value) {
+        return addGuardedBound({.layer = layer, .var = var, .hi = value});
+    }
+    Guard addGuardedLowerBound(LayerIndex layer, NodeIndex var, Float value) {
+        return addGuardedBound({.layer = layer, .var = var, .lo = value});
+    }
+    Guard addGuardedEquality(LayerIndex layer, NodeIndex var, Float value) {
+        return addGuardedBound({.layer = layer, .var = var, .lo = value, .hi = value});
+    }
+    Guard addGuardedInterval(LayerIndex layer, NodeIndex var, Float lo, Float hi) {
+        return addGuardedBound({.layer = layer, .var = var, .lo = lo, .hi = hi});
+    }
+
+    GuardedBound const & getGuardedBound(Guard guard) const { return guardedBounds[guard]; }
+
+    // Requires that `output[i] - output[node] > threshold` for some other output `i`
     virtual void addClassificationConstraint(NodeIndex node, Float threshold) = 0;
+    // Just one of the disjuncts of the classification constraint, with `i = otherNode`
+    virtual void addOutputDifferenceConstraint(NodeIndex, NodeIndex, Float) {
+        throw std::logic_error{"Output difference constraints are not supported by the verifier"};
+    }
 
     virtual void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) = 0;
 
@@ -47,8 +84,15 @@ public:
         reset();
     }
 
-    virtual void push() { pushImpl(); }
-    virtual void pop() { popImpl(); }
+    virtual void push() {
+        guardedBoundsLimits.push_back(guardedBounds.size());
+        pushImpl();
+    }
+    virtual void pop() {
+        popImpl();
+        guardedBounds.resize(guardedBoundsLimits.back());
+        guardedBoundsLimits.pop_back();
+    }
 
     virtual void setTimeLimit(std::chrono::milliseconds) {}
 
@@ -57,12 +101,19 @@ public:
         return checkImpl();
     }
 
+    // Checks the query as if the bounds of the given guards were also asserted
+    virtual Answer checkAssuming(std::span<Guard const> guards) {
+        ++checksCount;
+        return checkAssumingImpl(guards);
+    }
+
     std::size_t getChecksCount() const { return checksCount; }
 
     virtual void resetSampleQuery() {}
     virtual void resetSample() {
         resetSampleQuery();
         checksCount = 0;
+        resetGuardedBounds();
     }
     virtual void reset() { resetSample(); }
 
@@ -71,13 +122,57 @@ public:
 protected:
     virtual void initImpl() {}
 
+    void addUnguardedBound(GuardedBound const & bnd) {
+        auto const & [layer, var, lo, hi] = bnd;
+        bool const hasLower = (lo != GuardedBound::unboundedLower);
+        bool const hasUpper = (hi != GuardedBound::unboundedUpper);
+        if (hasLower and hasUpper) {
+            if (lo == hi) {
+                addEquality(layer, var, lo);
+            } else {
+                addInterval(layer, var, lo, hi);
+            }
+        } else if (hasLower) {
+            addLowerBound(layer, var, lo);
+        } else {
+            addUpperBound(layer, var, hi);
+        }
+    }
+
+    void resetGuardedBounds() {
+        guardedBounds.clear();
+        guardedBoundsLimits.clear();
+    }
+
     std::size_t checksCount{};
 
 private:
+    Guard addGuardedBound(GuardedBound bnd) {
+        Guard const guard = guardedBounds.size();
+        guardedBounds.push_back(bnd);
+        addGuardedBoundImpl(guard, guardedBounds.back());
+        return guard;
+    }
+
     virtual void pushImpl() = 0;
     virtual void popImpl() = 0;
 
     virtual Answer checkImpl() = 0;
+
+    // By default, the bounds are only stored and asserted within each check that assumes them
+    virtual void addGuardedBoundImpl(Guard, GuardedBound const &) {}
+    virtual Answer checkAssumingImpl(std::span<Guard const> guards) {
+        pushImpl();
+        for (Guard guard : guards) {
+            addUnguardedBound(getGuardedBound(guard));
+        }
+        Answer const answer = checkImpl();
+        popImpl();
+        return answer;
+    }
+
+    std::vector<GuardedBound> guardedBounds{};
+    std::vector<std::size_t> guardedBoundsLimits{};
 };
 } // namespace xai::verifiers
 
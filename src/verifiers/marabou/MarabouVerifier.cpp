@@ -3,8 +3,14 @@
 #include "Engine.h"
 #include "InputQuery.h"
 
+#include <spexplain/common/Profile.h>
+#include <spexplain/network/BoundPropagation.h>
+
 #include <cassert>
+#include <cmath>
+#include <memory>
 #include <numeric>
+#include <unordered_map>
 
 namespace xai::verifiers {
 
@@ -12,19 +18,50 @@ namespace {
 enum class VariableType {BACKWARD, FORWARD};
 using VarIndex = std::size_t;
 
+// Marabou computes in floating point with its own tolerances, the propagated bounds are hence loosened
+// s.t. they do not cut off the solutions that Marabou itself would accept
+constexpr Float hardNeuronBoundsSlack = 1e-6;
+
 class QueryIncrementalWrapper {
 public:
     static std::unique_ptr<QueryIncrementalWrapper> fromNNet(spexplain::Network const &);
 
-    std::unique_ptr<InputQuery> buildQuery() const;
+    // Applies the scoped bounds and equations to the base query in place and reverts them on destruction
+    // Only the piecewise-linear constraints are copied for each check: the engine notifies the constraints
+    // of the given query about its bounds, which may fix their phases for any later check
+    class ScopedQuery {
+    public:
+        explicit ScopedQuery(QueryIncrementalWrapper &);
+        ~ScopedQuery();
+        ScopedQuery(ScopedQuery const &) = delete;
+        ScopedQuery & operator=(ScopedQuery const &) = delete;
+
+        InputQuery & get() { return query; }
+
+    private:
+        struct SavedBound {
+            VarIndex var;
+            bool isLower;
+            double value;
+        };
+
+        InputQuery & query;
+        std::vector<SavedBound> savedBounds;
+        std::size_t nAddedEquations{0};
+        List<PiecewiseLinearConstraint *> baseConstraints;
+    };
 
     void push();
     void pop();
 
+    // Drops all the scopes, e.g. within a new sample
+    void clearScopes();
+
     void setLowerBound(LayerIndex layerNum, NodeIndex nodeIndex, Float);
     void setUpperBound(LayerIndex layerNum, NodeIndex nodeIndex, Float);
 
     void addClassificationConstraint(NodeIndex node, Float threshold);
+    void addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold);
 
 protected:
     std::unordered_map<VarIndex, Float> const & getLowerBounds() const { assert(not scopedLowerBounds.empty()); return scopedLowerBounds.back(); };
@@ -41,18 +78,21 @@ private:
     void markInputVariable(VarIndex);
     void markOutputVariable(VarIndex);
 
-    void addStructuralEquation(Equation eq) { structuralEquations.push_back(std::move(eq)); }
-    void setHardInputLowerBound(VarIndex, Float);
-    void setHardInputUpperBound(VarIndex, Float);
+    void addStructuralEquation(Equation eq) { baseQuery->addEquation(eq); }
+    void addRelu(VarIndex incoming, VarIndex outgoing);
+    void setHardLowerBound(VarIndex, Float);
+    void setHardUpperBound(VarIndex, Float);
+
+    // Bounds of the neurons that hold within the whole input domain
+    void setHardNeuronBounds(spexplain::Network const &);
 
     std::size_t numVars{0};
     std::vector<VarIndex> inputVariables;
     std::vector<VarIndex> outputVariables;
     std::vector<std::size_t> layerSizes;
-    std::vector<std::pair<VarIndex, VarIndex>> reluList;
-    std::vector<Equation> structuralEquations;
-    std::unordered_map<VarIndex, Float> hardInputLowerBounds;
-    std::unordered_map<VarIndex, Float> hardInputUpperBounds;
+
+    // The structure of the network and the hard bounds, built only once
+    std::unique_ptr<InputQuery> baseQuery{std::make_unique<InputQuery>()};
 
     std::vector<std::unordered_map<VarIndex, Float>> scopedLowerBounds;
     std::vector<std::unordered_map<VarIndex, Float>> scopedUpperBounds;
@@ -70,6 +110,7 @@ public:
     void addLowerBound(LayerIndex layer, NodeIndex var, Float value);
 
     void addClassificationConstraint(NodeIndex node, Float threshold);
+    void addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold);
 
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs);
 
@@ -80,6 +121,7 @@ public:
 
 private:
     std::unique_ptr<QueryIncrementalWrapper> queryWrapper;
+    spexplain::Network const * loadedNetworkPtr{};
 };
 
 MarabouVerifier::MarabouVerifier() : pimpl{std::make_unique<MarabouImpl>()} {}
@@ -102,6 +144,10 @@ void MarabouVerifier::addClassificationConstraint(NodeIndex node, Float threshol
     pimpl->addClassificationConstraint(node, threshold);
 }
 
+void MarabouVerifier::addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) {
+    pimpl->addOutputDifferenceConstraint(node, otherNode, threshold);
+}
+
 void MarabouVerifier::addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) {
     pimpl->addConstraint(layer, lhs, rhs);
 }
@@ -115,6 +161,7 @@ void MarabouVerifier::popImpl() {
 }
 
 Verifier::Answer MarabouVerifier::checkImpl() {
+    spexplain::Profile::Scope const profileScope{"marabou::check"};
     return pimpl->check();
 }
 
@@ -179,8 +226,8 @@ void QueryIncrementalWrapper::addClassificationConstraint(NodeIndex node, Float
     for (size_t i = 0; i < outputVariables.size(); ++i) {
         if (i != node) {
             // Retrieve the variable index for the current output node
-            auto currentNodeVarIndex = getVarIndex(layerSizes.size() - 1, i, VariableType::FORWARD);
-            auto targetNodeVarIndex = getVarIndex(layerSizes.size() - 1, node, VariableType::FORWARD);
+            auto currentNodeVarIndex = getVarIndex(layerSizes.size() - 1, i, VariableType::BACKWARD);
+            auto targetNodeVarIndex = getVarIndex(layerSizes.size() - 1, node, VariableType::BACKWARD);
 
             // Create an inequality:  currentNodeVar - targetNodeVar > threshold
             Equation inequality(Equation::GE);
@@ -197,12 +244,60 @@ void QueryIncrementalWrapper::addClassificationConstraint(NodeIndex node, Float
     throw std::logic_error("Unimplemented!");
 }
 
-void QueryIncrementalWrapper::setHardInputLowerBound(VarIndex var, Float val) {
-    hardInputLowerBounds[var] = val;
+void QueryIncrementalWrapper::addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) {
+    if (node >= outputVariables.size() or otherNode >= outputVariables.size()) {
+        throw std::out_of_range("Node index is out of range for outputVars.");
+    }
+    assert(node != otherNode);
+
+    // The output layer has no activation, hence only its backward variables are bound by the structural equations
+    auto otherNodeVarIndex = getVarIndex(layerSizes.size() - 1, otherNode, VariableType::BACKWARD);
+    auto targetNodeVarIndex = getVarIndex(layerSizes.size() - 1, node, VariableType::BACKWARD);
+
+    // Unlike the disjunction, a single inequality is supported; it is not strict, which is an over-approximation
+    Equation inequality(Equation::GE);
+    inequality.addAddend(1, otherNodeVarIndex);
+    inequality.addAddend(-1, targetNodeVarIndex);
+    inequality.setScalar(threshold);
+    getExtraEquations().push_back(std::move(inequality));
+}
+
+void QueryIncrementalWrapper::addRelu(VarIndex incoming, VarIndex outgoing) {
+    // The query takes the ownership of the constraint, and copies of the query duplicate it
+    baseQuery->addPiecewiseLinearConstraint(new ReluConstraint(incoming, outgoing));
+}
+
+void QueryIncrementalWrapper::setHardLowerBound(VarIndex var, Float val) {
+    baseQuery->setLowerBound(var, val);
+}
+
+void QueryIncrementalWrapper::setHardUpperBound(VarIndex var, Float val) {
+    baseQuery->setUpperBound(var, val);
 }
 
-void QueryIncrementalWrapper::setHardInputUpperBound(VarIndex var, Float val) {
-    hardInputUpperBounds[var] = val;
+void QueryIncrementalWrapper::setHardNeuronBounds(spexplain::Network const & network) {
+    std::size_t const nInputs = network.nInputs();
+    std::vector<Float> inputLowerBounds(nInputs);
+    std::vector<Float> inputUpperBounds(nInputs);
+    for (std::size_t node = 0; node < nInputs; ++node) {
+        inputLowerBounds[node] = network.getInputLowerBound(node);
+        inputUpperBounds[node] = network.getInputUpperBound(node);
+    }
+
+    spexplain::Network::BoundPropagation boundPropagation{network,
+                                                          spexplain::Network::BoundPropagation::Type::symbolic};
+    boundPropagation(inputLowerBounds, inputUpperBounds);
+
+    // Saves the preprocessing of each check from deriving these over and over again
+    for (std::size_t layerNum = 1; layerNum < network.nLayers(); ++layerNum) {
+        for (std::size_t node = 0; node < layerSizes[layerNum]; ++node) {
+            auto const var = getVarIndex(layerNum, node, VariableType::BACKWARD);
+            Float const lo = boundPropagation.getLowerBound(layerNum, node);
+            Float const hi = boundPropagation.getUpperBound(layerNum, node);
+            setHardLowerBound(var, lo - hardNeuronBoundsSlack * (1 + std::abs(lo)));
+            setHardUpperBound(var, hi + hardNeuronBoundsSlack * (1 + std::abs(hi)));
+        }
+    }
 }
 
 std::unique_ptr<QueryIncrementalWrapper> QueryIncrementalWrapper::fromNNet(spexplain::Network const & network) {
@@ -213,6 +308,8 @@ std::unique_ptr<QueryIncrementalWrapper> QueryIncrementalWrapper::fromNNet(spexp
         layerSizes.push_back(network.getLayerSize(layerNum));
     }
 
+    auto & baseQuery = *queryWrapper->baseQuery;
+
     // Register forward variables for input layer
     for (std::size_t node = 0; node < layerSizes[0]; ++node) {
         auto var = queryWrapper->registerNewVariable();
@@ -231,12 +328,20 @@ std::unique_ptr<QueryIncrementalWrapper> QueryIncrementalWrapper::fromNNet(spexp
         queryWrapper->markOutputVariable(var);
     }
 
+    baseQuery.setNumberOfVariables(queryWrapper->numVars);
+    for (std::size_t i = 0; i < queryWrapper->inputVariables.size(); ++i) {
+        baseQuery.markInputVariable(queryWrapper->inputVariables[i], i);
+    }
+    for (std::size_t i = 0; i < queryWrapper->outputVariables.size(); ++i) {
+        baseQuery.markOutputVariable(queryWrapper->outputVariables[i], i);
+    }
+
     // Build equations for each variable from weights and biases
     // RHS variables start from first hidden layer, i.e., we skip input layer
     for (std::size_t layerNum = 1; layerNum < network.nLayers(); ++layerNum) {
         for (std::size_t node = 0; node < network.getLayerSize(layerNum); ++node) {
             Equation eq;
-            auto const & weights = network.getWeights(layerNum, node);
+            auto const weights = network.getWeights(layerNum, node);
             assert(weights.size() == network.getLayerSize(layerNum - 1));
             for (std::size_t incomingIndex = 0; incomingIndex < weights.size(); ++incomingIndex) {
                 auto var = queryWrapper->getVarIndex(layerNum - 1, incomingIndex, VariableType::FORWARD);
@@ -250,70 +355,78 @@ std::unique_ptr<QueryIncrementalWrapper> QueryIncrementalWrapper::fromNNet(spexp
     // Add ReLUs
     for (std::size_t layerNum = 1; layerNum < network.nLayers() - 1; ++layerNum) {
         for (std::size_t node = 0; node < network.getLayerSize(layerNum); ++node) {
-            queryWrapper->reluList.emplace_back(queryWrapper->getVarIndex(layerNum, node, VariableType::BACKWARD),
-                                                queryWrapper->getVarIndex(layerNum, node, VariableType::FORWARD)
-            );
+            queryWrapper->addRelu(queryWrapper->getVarIndex(layerNum, node, VariableType::BACKWARD),
+                                  queryWrapper->getVarIndex(layerNum, node, VariableType::FORWARD));
         }
     }
 
     // Add input lower and upper bounds
     for (std::size_t node = 0; node < layerSizes[0]; ++node) {
-        queryWrapper->setHardInputLowerBound(queryWrapper->getVarIndex(0, node, VariableType::FORWARD), network.getInputLowerBound(node));
-        queryWrapper->setHardInputUpperBound(queryWrapper->getVarIndex(0, node, VariableType::FORWARD), network.getInputUpperBound(node));
+        queryWrapper->setHardLowerBound(queryWrapper->getVarIndex(0, node, VariableType::FORWARD), network.getInputLowerBound(node));
+        queryWrapper->setHardUpperBound(queryWrapper->getVarIndex(0, node, VariableType::FORWARD), network.getInputUpperBound(node));
     }
 
+    queryWrapper->setHardNeuronBounds(network);
+
     return queryWrapper;
 }
 
-std::unique_ptr<InputQuery> QueryIncrementalWrapper::buildQuery() const {
-    auto query = std::make_unique<InputQuery>();
-
-    query->setNumberOfVariables(numVars);
-
-    for (std::size_t i = 0; i < inputVariables.size(); i++) {
-        query->markInputVariable(inputVariables[i], i);
-    }
-
-    for (std::size_t i = 0; i < outputVariables.size(); i++) {
-        query->markOutputVariable(outputVariables[i], i);
-    }
-
-    for (auto const & eq : structuralEquations) {
-        query->addEquation(eq);
-    }
-
-    for (auto && [var, val] : hardInputLowerBounds) {
-        query->setLowerBound(var, val);
+QueryIncrementalWrapper::ScopedQuery::ScopedQuery(QueryIncrementalWrapper & wrapper) : query{*wrapper.baseQuery} {
+    for (auto const & eqs : wrapper.scopedExtraEquations) {
+        for (auto const & eq : eqs) {
+            query.addEquation(eq);
+            ++nAddedEquations;
+        }
     }
 
-    for (auto && [var, val] : hardInputUpperBounds) {
-        query->setUpperBound(var, val);
+    // Only tighten the bounds, the hard bounds must hold anyway
+    for (auto const & los : wrapper.scopedLowerBounds) {
+        for (auto && [var, val] : los) {
+            double const lo = query.getLowerBound(var);
+            if (val <= lo) { continue; }
+            savedBounds.push_back({.var = var, .isLower = true, .value = lo});
+            query.setLowerBound(var, val);
+        }
     }
 
-    for (auto const & eqs : scopedExtraEquations) {
-        for (auto const & eq : eqs) {
-            query->addEquation(eq);
+    for (auto const & his : wrapper.scopedUpperBounds) {
+        for (auto && [var, val] : his) {
+            double const hi = query.getUpperBound(var);
+            if (val >= hi) { continue; }
+            savedBounds.push_back({.var = var, .isLower = false, .value = hi});
+            query.setUpperBound(var, val);
         }
     }
 
-    for (auto && [incoming, outgoing] : reluList) {
-        // TODO: Check with Marabou, this looks like memory leak
-        query->addPiecewiseLinearConstraint(new ReluConstraint(incoming, outgoing));
+    auto & constraints = query.getPiecewiseLinearConstraints();
+    baseConstraints = constraints;
+    constraints.clear();
+    for (auto const * constraint : baseConstraints) {
+        constraints.append(constraint->duplicateConstraint());
     }
+}
 
-    for (auto const & los : scopedLowerBounds) {
-        for (auto && [var, val] : los) {
-            query->setLowerBound(var, val);
-        }
+QueryIncrementalWrapper::ScopedQuery::~ScopedQuery() {
+    auto & constraints = query.getPiecewiseLinearConstraints();
+    for (auto * constraint : constraints) {
+        delete constraint;
     }
-
-    for (auto const & his : scopedUpperBounds) {
-        for (auto && [var, val] : his) {
-            query->setUpperBound(var, val);
+    constraints = baseConstraints;
+
+    // In the reverse order, because the same bound may have been tightened within multiple scopes
+    for (auto it = savedBounds.rbegin(); it != savedBounds.rend(); ++it) {
+        if (it->isLower) {
+            query.setLowerBound(it->var, it->value);
+        } else {
+            query.setUpperBound(it->var, it->value);
         }
     }
 
-    return query;
+    // The scoped equations were appended after all the structural ones
+    auto & equations = query.getEquations();
+    for (std::size_t i = 0; i < nAddedEquations; ++i) {
+        equations.popBack();
+    }
 }
 
 void QueryIncrementalWrapper::push() {
@@ -331,6 +444,12 @@ void QueryIncrementalWrapper::pop() {
     scopedUpperBounds.pop_back();
 }
 
+void QueryIncrementalWrapper::clearScopes() {
+    scopedExtraEquations.clear();
+    scopedLowerBounds.clear();
+    scopedUpperBounds.clear();
+}
+
 }
 
 MarabouVerifier::MarabouImpl::MarabouImpl() {
@@ -338,7 +457,15 @@ MarabouVerifier::MarabouImpl::MarabouImpl() {
 }
 
 void MarabouVerifier::MarabouImpl::loadModel(const spexplain::Network & network) {
+    // The base query is built only once per network, including the bound propagation
+    if (loadedNetworkPtr == &network) {
+        assert(queryWrapper);
+        queryWrapper->clearScopes();
+        return;
+    }
+
     queryWrapper = QueryIncrementalWrapper::fromNNet(network);
+    loadedNetworkPtr = &network;
 }
 
 void MarabouVerifier::MarabouImpl::push() {
@@ -369,10 +496,9 @@ Verifier::Answer toAnswer(Engine::ExitCode exitCode) {
 }
 
 Verifier::Answer MarabouVerifier::MarabouImpl::check() {
-    auto queryPtr = queryWrapper->buildQuery();
-    auto & query = *queryPtr;
+    QueryIncrementalWrapper::ScopedQuery scopedQuery{*queryWrapper};
     Engine engine;
-    bool continueWithSolving = engine.processInputQuery(query, true);
+    bool continueWithSolving = engine.processInputQuery(scopedQuery.get(), true);
     if (not continueWithSolving) {
         return toAnswer(engine.getExitCode());
     }
@@ -399,4 +525,9 @@ void MarabouVerifier::MarabouImpl::addLowerBound(LayerIndex layer, NodeIndex nod
 void MarabouVerifier::MarabouImpl::addClassificationConstraint(NodeIndex node, Float threshold) {
     queryWrapper->addClassificationConstraint(node, threshold);
 }
+
+void MarabouVerifier::MarabouImpl::addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode,
+                                                                 Float threshold) {
+    queryWrapper->addOutputDifferenceConstraint(node, otherNode, threshold);
+}
 } // namespace xai::verifiers
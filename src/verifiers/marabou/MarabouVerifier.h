@@ -24,6 +24,8 @@ public:
 
     void addClassificationConstraint(NodeIndex node, Float threshold) override;
 
+    void addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) override;
+
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) override;
 
     void printSmtLib2Query(std::ostream &) const override;
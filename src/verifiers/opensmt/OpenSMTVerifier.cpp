@@ -1,25 +1,39 @@
 #include "OpenSMTVerifier.h"
 
+#include <verifiers/InputBox.h>
+
+#include <spexplain/common/Profile.h>
+
 #include <api/MainSolver.h>
-#include <common/StringConv.h>
 #include <logics/ArithLogic.h>
 #include <logics/LogicFactory.h>
 
 #include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace xai::verifiers {
 
 using namespace opensmt;
 
 namespace { // Helper methods
+// Exact, the floating-point values are dyadic rationals
 FastRational floatToRational(Float value);
 }
 
 class OpenSMTVerifier::OpenSMTImpl {
 public:
+    void setBoundPropagation(spexplain::Network::BoundPropagation::Type type) { boundPropagationType = type; }
+
     bool contains(PTRef const &, NodeIndex) const;
 
     std::size_t termSizeOf(PTRef const &) const;
@@ -32,31 +46,31 @@ public:
     void addExplanationTerm(PTRef const &, std::string termNamePrefix = "");
 
     PTRef makeUpperBound(LayerIndex layer, NodeIndex node, Float value) {
-        return makeUpperBound(layer, node, floatToRational(value));
+        return makeUpperBound(layer, node, mkRealConst(value));
     }
     PTRef makeLowerBound(LayerIndex layer, NodeIndex node, Float value) {
-        return makeLowerBound(layer, node, floatToRational(value));
+        return makeLowerBound(layer, node, mkRealConst(value));
     }
     PTRef makeEquality(LayerIndex layer, NodeIndex node, Float value) {
-        return makeEquality(layer, node, floatToRational(value));
+        PTRef valueTerm = mkRealConst(value);
+        return makeInterval(layer, node, valueTerm, valueTerm);
     }
     PTRef makeInterval(LayerIndex layer, NodeIndex node, Float lo, Float hi) {
-        return makeInterval(layer, node, floatToRational(lo), floatToRational(hi));
+        return makeInterval(layer, node, mkRealConst(lo), mkRealConst(hi));
     }
-    PTRef makeUpperBound(LayerIndex layer, NodeIndex node, FastRational value);
-    PTRef makeLowerBound(LayerIndex layer, NodeIndex node, FastRational value);
-    PTRef makeEquality(LayerIndex layer, NodeIndex node, FastRational value) {
-        FastRational valueCp = value;
-        return makeInterval(layer, node, std::move(value), std::move(valueCp));
-    }
-    PTRef makeInterval(LayerIndex layer, NodeIndex node, FastRational lo, FastRational hi);
+    PTRef makeUpperBound(LayerIndex layer, NodeIndex node, PTRef valueTerm);
+    PTRef makeLowerBound(LayerIndex layer, NodeIndex node, PTRef valueTerm);
+    PTRef makeInterval(LayerIndex layer, NodeIndex node, PTRef loTerm, PTRef hiTerm);
 
     PTRef addUpperBound(LayerIndex layer, NodeIndex node, Float value, bool explanationTerm = false);
     PTRef addLowerBound(LayerIndex layer, NodeIndex node, Float value, bool explanationTerm = false);
     PTRef addEquality(LayerIndex layer, NodeIndex node, Float value, bool explanationTerm = false);
     PTRef addInterval(LayerIndex layer, NodeIndex node, Float lo, Float hi, bool explanationTerm = false);
 
+    void addGuardedBound(Guard, GuardedBound const &);
+
     void addClassificationConstraint(NodeIndex node, Float threshold);
+    void addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold);
 
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs);
 
@@ -68,6 +82,7 @@ public:
     void setTimeLimit(std::chrono::milliseconds);
 
     Answer check();
+    Answer checkAssuming(std::span<Guard const>);
 
     void resetSampleQuery();
     void resetSample();
@@ -81,6 +96,24 @@ public:
     void printSmtLib2Query(std::ostream &) const;
 
 private:
+    // The logic is kept across samples unless it grew too much with the terms of the particular samples
+    static constexpr std::size_t maxSamplesPerLogic = 1024;
+
+    void encodeModel(spexplain::Network const &);
+
+    // The constants are cached, most of them repeat across the samples and the checks
+    PTRef mkRealConst(Float value);
+
+    bool usingBoundPropagation() const { return bool(boundPropagationPtr); }
+
+    void updateInputBox(LayerIndex layer, NodeIndex node, Float lo, Float hi) {
+        if (layer != 0 or not usingBoundPropagation()) { return; }
+        inputBox.tightenInterval(node, lo, hi);
+        inputBoxChanged = true;
+    }
+
+    void fixStablePhases();
+
     //! sync with the framework
     static std::string inputVarName(NodeIndex node) {
         return "x" + std::to_string(node + 1);
@@ -106,6 +139,30 @@ private:
     std::vector<PTRef> outputVars;
     std::vector<std::size_t> layerSizes;
 
+    // Encoding of the network within the current logic, built once per network
+    spexplain::Network const * encodedNetworkPtr{};
+    PTRef inputDomainsTerm{};
+    std::map<std::pair<NodeIndex, Float>, PTRef> classificationTerms{};
+    std::size_t samplesInLogicCount{};
+    // Within the current logic
+    std::unordered_map<Float, PTRef> realConstTerms{};
+
+    // Conditions of the ReLUs of the hidden layers, indexed by the layer
+    std::vector<std::vector<PTRef>> reluConditions{};
+
+    std::optional<spexplain::Network::BoundPropagation::Type> boundPropagationType{};
+    std::unique_ptr<spexplain::Network::BoundPropagation> boundPropagationPtr{};
+    InputBox inputBox{};
+    bool inputBoxChanged{};
+    // The phases of ReLUs that are already asserted, undone on pop
+    std::vector<std::vector<bool>> fixedPhases{};
+    std::vector<std::pair<LayerIndex, NodeIndex>> fixedPhasesTrail{};
+    std::vector<std::size_t> fixedPhasesTrailLimits{};
+
+    // Indexed by the guards, which are reused after a pop, unlike the names of the guard variables
+    std::vector<std::pair<PTRef, GuardedBound>> guardTerms{};
+    std::size_t guardVarsCount{};
+
     std::vector<NodeIndex> unsatCoreNodeFilter;
 
     std::vector<PTRef> explanationTerms;
@@ -122,6 +179,10 @@ OpenSMTVerifier::OpenSMTVerifier() : pimpl{std::make_unique<OpenSMTImpl>()} {}
 
 OpenSMTVerifier::~OpenSMTVerifier() {}
 
+void OpenSMTVerifier::setBoundPropagation(spexplain::Network::BoundPropagation::Type type) {
+    pimpl->setBoundPropagation(type);
+}
+
 bool OpenSMTVerifier::contains(PTRef const & term, NodeIndex node) const {
     return pimpl->contains(term, node);
 }
@@ -162,10 +223,18 @@ void OpenSMTVerifier::addInterval(LayerIndex layer, NodeIndex var, Float lo, Flo
     pimpl->addInterval(layer, var, lo, hi, explanationTerm);
 }
 
+void OpenSMTVerifier::addGuardedBoundImpl(Guard guard, GuardedBound const & bnd) {
+    pimpl->addGuardedBound(guard, bnd);
+}
+
 void OpenSMTVerifier::addClassificationConstraint(NodeIndex node, Float threshold=0) {
     pimpl->addClassificationConstraint(node, threshold);
 }
 
+void OpenSMTVerifier::addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) {
+    pimpl->addOutputDifferenceConstraint(node, otherNode, threshold);
+}
+
 void OpenSMTVerifier::addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) {
     pimpl->addConstraint(layer, lhs, rhs);
 }
@@ -190,6 +259,10 @@ Verifier::Answer OpenSMTVerifier::checkImpl() {
     return pimpl->check();
 }
 
+Verifier::Answer OpenSMTVerifier::checkAssumingImpl(std::span<Guard const> guards) {
+    return pimpl->checkAssuming(guards);
+}
+
 void OpenSMTVerifier::resetSampleQuery() {
     pimpl->resetSampleQuery();
     UnsatCoreVerifier::resetSampleQuery();
@@ -226,15 +299,53 @@ void OpenSMTVerifier::printSmtLib2Query(std::ostream & os) const {
  */
 
 namespace { // Helper methods
-FastRational floatToRational(Float value) {
-    auto s = std::to_string(value);
-    char* rationalString;
-    opensmt::stringToRational(rationalString, s.c_str());
-    auto res = FastRational(rationalString);
-    free(rationalString);
+// The words of FastRational may be narrower than the mantissa of Float
+constexpr int wordDigits = std::numeric_limits<word>::digits;
+constexpr int uwordDigits = std::numeric_limits<uword>::digits;
+
+FastRational pow2(int exp) {
+    assert(exp >= 0);
+    constexpr int maxStep = wordDigits - 1;
+
+    FastRational res{word{1} << (exp % maxStep)};
+    for (int i = 0; i < exp / maxStep; ++i) {
+        res *= FastRational{word{1} << maxStep};
+    }
     return res;
 }
 
+// value = mantissa * 2^exp, where the mantissa is an odd integer
+FastRational floatToRational(Float value) {
+    assert(std::isfinite(value));
+    if (value == 0) { return FastRational{word{0}}; }
+
+    constexpr int mantissaDigits = std::numeric_limits<Float>::digits;
+    static_assert(mantissaDigits <= 2 * wordDigits);
+
+    int exp;
+    Float const fraction = std::frexp(std::abs(value), &exp);
+    auto mantissa = static_cast<std::uint64_t>(std::ldexp(fraction, mantissaDigits));
+    exp -= mantissaDigits;
+
+    int const trailingZeros = std::countr_zero(mantissa);
+    mantissa >>= trailingZeros;
+    exp += trailingZeros;
+
+    bool const negative = (value < 0);
+    // The common case, without any arithmetic on rationals
+    if (std::bit_width(mantissa) <= wordDigits and exp <= 0 and -exp < uwordDigits) {
+        auto const num = static_cast<word>(mantissa);
+        return FastRational{negative ? -num : num, uword{1} << -exp};
+    }
+
+    constexpr std::uint64_t lowMask = (std::uint64_t{1} << wordDigits) - 1;
+    FastRational res = FastRational{static_cast<word>(mantissa >> wordDigits)} * pow2(wordDigits) +
+                       FastRational{static_cast<word>(mantissa & lowMask)};
+    if (negative) { res = -res; }
+    if (exp < 0) { return res / pow2(-exp); }
+    return res * pow2(exp);
+}
+
 Verifier::Answer toAnswer(sstat res) {
     if (res == s_False)
         return Verifier::Answer::UNSAT;
@@ -280,6 +391,35 @@ std::size_t OpenSMTVerifier::OpenSMTImpl::termSizeOf(PTRef const & term) const {
 }
 
 void OpenSMTVerifier::OpenSMTImpl::loadModel(spexplain::Network const & network) {
+    if (encodedNetworkPtr != &network) { encodeModel(network); }
+    assert(encodedNetworkPtr == &network);
+
+    addTerm(inputDomainsTerm);
+
+    if (not boundPropagationType) { return; }
+
+    if (not boundPropagationPtr or &boundPropagationPtr->getNetwork() != &network) {
+        // The constants within the solver are exactly the floating-point values, no need to set the constants error
+        boundPropagationPtr = std::make_unique<spexplain::Network::BoundPropagation>(network, *boundPropagationType);
+    }
+
+    inputBox.reset(network);
+    inputBoxChanged = true;
+
+    fixedPhases.resize(reluConditions.size());
+    for (LayerIndex layer = 0; layer < reluConditions.size(); ++layer) {
+        fixedPhases[layer].assign(reluConditions[layer].size(), false);
+    }
+    fixedPhasesTrail.clear();
+    fixedPhasesTrailLimits.clear();
+}
+
+void OpenSMTVerifier::OpenSMTImpl::encodeModel(spexplain::Network const & network) {
+    inputVars.clear();
+    outputVars.clear();
+    classificationTerms.clear();
+    reluConditions.assign(network.nLayers() - 1, {});
+
     // create input variables
     for (NodeIndex i = 0u; i < network.getLayerSize(0); ++i) {
         auto name = inputVarName(i);
@@ -294,18 +434,20 @@ void OpenSMTVerifier::OpenSMTImpl::loadModel(spexplain::Network const & network)
         for (NodeIndex node = 0u; node < network.getLayerSize(layer); ++node) {
             std::vector<PTRef> addends;
             Float bias = network.getBias(layer, node);
-            auto const & weights = network.getWeights(layer, node);
-            PTRef biasTerm = logic->mkRealConst(floatToRational(bias));
+            auto const weights = network.getWeights(layer, node);
+            PTRef biasTerm = mkRealConst(bias);
             addends.push_back(biasTerm);
 
             assert(previousLayerRefs.size() == weights.size());
             for (int j = 0; j < weights.size(); j++) {
-                PTRef weightTerm = logic->mkRealConst(floatToRational(weights[j]));
+                PTRef weightTerm = mkRealConst(weights[j]);
                 PTRef addend = logic->mkTimes(weightTerm, previousLayerRefs[j]);
                 addends.push_back(addend);
             }
             PTRef input = logic->mkPlus(addends);
-            PTRef relu = logic->mkIte(logic->mkGeq(input, logic->getTerm_RealZero()), input, logic->getTerm_RealZero());
+            PTRef reluCondition = logic->mkGeq(input, logic->getTerm_RealZero());
+            PTRef relu = logic->mkIte(reluCondition, input, logic->getTerm_RealZero());
+            reluConditions[layer].push_back(reluCondition);
             currentLayerRefs.push_back(relu);
         }
         previousLayerRefs = std::move(currentLayerRefs);
@@ -319,13 +461,13 @@ void OpenSMTVerifier::OpenSMTImpl::loadModel(spexplain::Network const & network)
     for (NodeIndex node = 0u; node < lastLayerSize; ++node) {
         std::vector<PTRef> addends;
         Float bias = network.getBias(lastLayerIndex, node);
-        auto const & weights = network.getWeights(lastLayerIndex, node);
-        PTRef biasTerm = logic->mkRealConst(floatToRational(bias));
+        auto const weights = network.getWeights(lastLayerIndex, node);
+        PTRef biasTerm = mkRealConst(bias);
         addends.push_back(biasTerm);
 
         assert(previousLayerRefs.size() == weights.size());
         for (int j = 0; j < weights.size(); j++) {
-            PTRef weightTerm = logic->mkRealConst(floatToRational(weights[j]));
+            PTRef weightTerm = mkRealConst(weights[j]);
             PTRef addend = logic->mkTimes(weightTerm, previousLayerRefs[j]);
             addends.push_back(addend);
         }
@@ -344,10 +486,12 @@ void OpenSMTVerifier::OpenSMTImpl::loadModel(spexplain::Network const & network)
     for (NodeIndex i = 0; i < inputVars.size(); ++i) {
         Float lb = network.getInputLowerBound(i);
         Float ub = network.getInputUpperBound(i);
-        bounds.push_back(logic->mkGeq(inputVars[i], logic->mkRealConst(floatToRational(lb))));
-        bounds.push_back(logic->mkLeq(inputVars[i], logic->mkRealConst(floatToRational(ub))));
+        bounds.push_back(logic->mkGeq(inputVars[i], mkRealConst(lb)));
+        bounds.push_back(logic->mkLeq(inputVars[i], mkRealConst(ub)));
     }
-    addTerm(logic->mkAnd(bounds));
+    inputDomainsTerm = logic->mkAnd(bounds);
+
+    encodedNetworkPtr = &network;
 }
 
 void OpenSMTVerifier::OpenSMTImpl::setUnsatCoreFilter(std::vector<NodeIndex> const & filter) {
@@ -375,28 +519,38 @@ void OpenSMTVerifier::OpenSMTImpl::addExplanationTerm(PTRef const & term, std::s
     assert(success);
 }
 
-PTRef OpenSMTVerifier::OpenSMTImpl::makeUpperBound(LayerIndex layer, NodeIndex node, FastRational value) {
+PTRef OpenSMTVerifier::OpenSMTImpl::mkRealConst(Float value) {
+    // -0 and +0 share the same entry, which is fine
+    if (auto it = realConstTerms.find(value); it != realConstTerms.end()) { return it->second; }
+
+    PTRef term = logic->mkRealConst(floatToRational(value));
+    realConstTerms.emplace(value, term);
+    return term;
+}
+
+PTRef OpenSMTVerifier::OpenSMTImpl::makeUpperBound(LayerIndex layer, NodeIndex node, PTRef valueTerm) {
     if (layer != 0 and layer != layerSizes.size() - 1)
         throw std::logic_error("Unimplemented!");
     PTRef var = layer == 0 ? inputVars.at(node) : outputVars.at(node);
-    return logic->mkLeq(var, logic->mkRealConst(value));
+    return logic->mkLeq(var, valueTerm);
 }
 
-PTRef OpenSMTVerifier::OpenSMTImpl::makeLowerBound(LayerIndex layer, NodeIndex node, FastRational value) {
+PTRef OpenSMTVerifier::OpenSMTImpl::makeLowerBound(LayerIndex layer, NodeIndex node, PTRef valueTerm) {
     if (layer != 0 and layer != layerSizes.size() - 1)
         throw std::logic_error("Unimplemented!");
     PTRef var = layer == 0 ? inputVars.at(node) : outputVars.at(node);
-    return logic->mkGeq(var, logic->mkRealConst(value));
+    return logic->mkGeq(var, valueTerm);
 }
 
-PTRef OpenSMTVerifier::OpenSMTImpl::makeInterval(LayerIndex layer, NodeIndex node, FastRational lo, FastRational hi) {
-    PTRef lterm = makeLowerBound(layer, node, std::move(lo));
-    PTRef uterm = makeUpperBound(layer, node, std::move(hi));
+PTRef OpenSMTVerifier::OpenSMTImpl::makeInterval(LayerIndex layer, NodeIndex node, PTRef loTerm, PTRef hiTerm) {
+    PTRef lterm = makeLowerBound(layer, node, loTerm);
+    PTRef uterm = makeUpperBound(layer, node, hiTerm);
     return logic->mkAnd(lterm, uterm);
 }
 
 PTRef OpenSMTVerifier::OpenSMTImpl::addUpperBound(LayerIndex layer, NodeIndex node, Float value, bool explanationTerm) {
     PTRef term = makeUpperBound(layer, node, value);
+    updateInputBox(layer, node, std::numeric_limits<Float>::lowest(), value);
     if (not explanationTerm) {
         addTerm(term);
         return term;
@@ -412,6 +566,7 @@ PTRef OpenSMTVerifier::OpenSMTImpl::addUpperBound(LayerIndex layer, NodeIndex no
 
 PTRef OpenSMTVerifier::OpenSMTImpl::addLowerBound(LayerIndex layer, NodeIndex node, Float value, bool explanationTerm) {
     PTRef term = makeLowerBound(layer, node, value);
+    updateInputBox(layer, node, value, std::numeric_limits<Float>::max());
     if (not explanationTerm) {
         addTerm(term);
         return term;
@@ -427,6 +582,7 @@ PTRef OpenSMTVerifier::OpenSMTImpl::addLowerBound(LayerIndex layer, NodeIndex no
 
 PTRef OpenSMTVerifier::OpenSMTImpl::addEquality(LayerIndex layer, NodeIndex node, Float value, bool explanationTerm) {
     PTRef term = makeEquality(layer, node, value);
+    updateInputBox(layer, node, value, value);
     if (not explanationTerm) {
         addTerm(term);
         return term;
@@ -442,6 +598,7 @@ PTRef OpenSMTVerifier::OpenSMTImpl::addEquality(LayerIndex layer, NodeIndex node
 
 PTRef OpenSMTVerifier::OpenSMTImpl::addInterval(LayerIndex layer, NodeIndex node, Float lo, Float hi, bool explanationTerm) {
     PTRef term = makeInterval(layer, node, lo, hi);
+    updateInputBox(layer, node, lo, hi);
     if (not explanationTerm) {
         addTerm(term);
         return term;
@@ -455,12 +612,42 @@ PTRef OpenSMTVerifier::OpenSMTImpl::addInterval(LayerIndex layer, NodeIndex node
     return term;
 }
 
+void OpenSMTVerifier::OpenSMTImpl::addGuardedBound(Guard guard, GuardedBound const & bnd) {
+    auto const & [layer, node, lo, hi] = bnd;
+    bool const hasLower = (lo != GuardedBound::unboundedLower);
+    bool const hasUpper = (hi != GuardedBound::unboundedUpper);
+    assert(hasLower or hasUpper);
+
+    PTRef term;
+    if (hasLower and hasUpper) {
+        term = (lo == hi) ? makeEquality(layer, node, lo) : makeInterval(layer, node, lo, hi);
+    } else if (hasLower) {
+        term = makeLowerBound(layer, node, lo);
+    } else {
+        term = makeUpperBound(layer, node, hi);
+    }
+
+    // Only the guard variable is asserted within each check, the bound itself is asserted just once
+    std::string const guardVarName = "g_" + std::to_string(guardVarsCount++);
+    PTRef const guardVar = logic->mkBoolVar(guardVarName.c_str());
+    addTerm(logic->mkImpl(guardVar, term));
+
+    if (guard >= guardTerms.size()) { guardTerms.resize(guard + 1); }
+    guardTerms[guard] = {guardVar, bnd};
+}
+
 void OpenSMTVerifier::OpenSMTImpl::addClassificationConstraint(NodeIndex node, Float threshold=0.0){
     // Ensure the node index is within the range of outputVars
     if (node >= outputVars.size()) {
         throw std::out_of_range("Node index is out of range for outputVars.");
     }
 
+    auto const key = std::make_pair(node, threshold);
+    if (auto it = classificationTerms.find(key); it != classificationTerms.end()) {
+        addTerm(it->second);
+        return;
+    }
+
     PTRef targetNodeVar = outputVars[node];
     std::vector<PTRef> constraints;
 
@@ -468,7 +655,7 @@ void OpenSMTVerifier::OpenSMTImpl::addClassificationConstraint(NodeIndex node, F
         if (i != node) {
             // Create a constraint: (targetNodeVar - outputVars[i]) > threshold
             PTRef diff = logic->mkMinus(outputVars[i], targetNodeVar);
-            PTRef thresholdConst = logic->mkRealConst(floatToRational(threshold));
+            PTRef thresholdConst = mkRealConst(threshold);
             PTRef constraint = logic->mkGt(diff, thresholdConst);
             constraints.push_back(constraint);
         }
@@ -476,10 +663,24 @@ void OpenSMTVerifier::OpenSMTImpl::addClassificationConstraint(NodeIndex node, F
 
     if (!constraints.empty()) {
         PTRef combinedConstraint = logic->mkOr(constraints);
+        classificationTerms.emplace(key, combinedConstraint);
         addTerm(combinedConstraint);
     }
 }
 
+void OpenSMTVerifier::OpenSMTImpl::addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode,
+                                                                 Float threshold) {
+    if (node >= outputVars.size() or otherNode >= outputVars.size()) {
+        throw std::out_of_range("Node index is out of range for outputVars.");
+    }
+    assert(node != otherNode);
+
+    // (outputVars[otherNode] - outputVars[node]) > threshold
+    PTRef diff = logic->mkMinus(outputVars[otherNode], outputVars[node]);
+    PTRef thresholdConst = mkRealConst(threshold);
+    addTerm(logic->mkGt(diff, thresholdConst));
+}
+
 void
 OpenSMTVerifier::OpenSMTImpl::addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) {
     throw std::logic_error("Unimplemented!");
@@ -487,10 +688,29 @@ OpenSMTVerifier::OpenSMTImpl::addConstraint(LayerIndex layer, std::vector<std::p
 
 void OpenSMTVerifier::OpenSMTImpl::push() {
     solver->push();
+
+    if (not usingBoundPropagation()) { return; }
+
+    inputBox.push();
+    fixedPhasesTrailLimits.push_back(fixedPhasesTrail.size());
 }
 
 void OpenSMTVerifier::OpenSMTImpl::pop() {
     solver->pop();
+
+    if (not usingBoundPropagation()) { return; }
+
+    inputBox.pop();
+    inputBoxChanged = true;
+
+    assert(not fixedPhasesTrailLimits.empty());
+    std::size_t const trailSize = fixedPhasesTrailLimits.back();
+    fixedPhasesTrailLimits.pop_back();
+    while (fixedPhasesTrail.size() > trailSize) {
+        auto const [layer, node] = fixedPhasesTrail.back();
+        fixedPhases[layer][node] = false;
+        fixedPhasesTrail.pop_back();
+    }
 }
 
 void OpenSMTVerifier::OpenSMTImpl::setTimeLimit(std::chrono::milliseconds limit) {
@@ -498,10 +718,62 @@ void OpenSMTVerifier::OpenSMTImpl::setTimeLimit(std::chrono::milliseconds limit)
 }
 
 Verifier::Answer OpenSMTVerifier::OpenSMTImpl::check() {
+    spexplain::Profile::Scope const profileScope{"opensmt::check"};
+    if (usingBoundPropagation() and inputBoxChanged) { fixStablePhases(); }
+
     auto res = solver->check();
     return toAnswer(res);
 }
 
+Verifier::Answer OpenSMTVerifier::OpenSMTImpl::checkAssuming(std::span<Guard const> guards) {
+    // Asserting just the guard variables keeps the learnt clauses that involve the guarded bounds
+    push();
+    for (Guard guard : guards) {
+        assert(guard < guardTerms.size());
+        auto const & [guardVar, bnd] = guardTerms[guard];
+        addTerm(guardVar);
+        updateInputBox(bnd.layer, bnd.var, bnd.lo, bnd.hi);
+    }
+    Answer const answer = check();
+    pop();
+
+    return answer;
+}
+
+void OpenSMTVerifier::OpenSMTImpl::fixStablePhases() {
+    assert(usingBoundPropagation());
+    inputBoxChanged = false;
+
+    // Trivially unsatisfiable anyway
+    if (inputBox.isEmpty()) { return; }
+    // The phases would not be tracked within the unsat cores
+    if (not explanationTerms.empty()) { return; }
+
+    auto & boundPropagation = *boundPropagationPtr;
+    boundPropagation(inputBox.getLowerBounds(), inputBox.getUpperBounds());
+
+    // The stable ReLUs become just linear or zero within the solver
+    for (LayerIndex layer = 1; layer < reluConditions.size(); ++layer) {
+        auto const & layerReluConditions = reluConditions[layer];
+        auto & layerFixedPhases = fixedPhases[layer];
+        for (NodeIndex node = 0; node < layerReluConditions.size(); ++node) {
+            if (layerFixedPhases[node]) { continue; }
+
+            PTRef const & reluCondition = layerReluConditions[node];
+            if (boundPropagation.isStablyActive(layer, node)) {
+                addTerm(reluCondition);
+            } else if (boundPropagation.isStablyInactive(layer, node)) {
+                addTerm(logic->mkNot(reluCondition));
+            } else {
+                continue;
+            }
+
+            layerFixedPhases[node] = true;
+            fixedPhasesTrail.emplace_back(layer, node);
+        }
+    }
+}
+
 void OpenSMTVerifier::OpenSMTImpl::init() {
     config = std::make_unique<SMTConfig>();
     char const * msg = "ok";
@@ -510,6 +782,9 @@ void OpenSMTVerifier::OpenSMTImpl::init() {
     config->setProduceProofs();
     config->setOption(SMTConfig::o_produce_inter, SMTOption(true), msg);
 
+    // Start over with a new logic
+    logic.reset();
+
     // reset() is called by Verifier
 }
 
@@ -529,15 +804,25 @@ void OpenSMTVerifier::OpenSMTImpl::resetSample() {
 }
 
 void OpenSMTVerifier::OpenSMTImpl::reset() {
-    logic = std::make_unique<ArithLogic>(opensmt::Logic_t::QF_LRA);
+    // The solver is always created anew, the encoding of the network is reused within the same logic
+    solver.reset();
+    if (not logic or samplesInLogicCount >= maxSamplesPerLogic) {
+        logic = std::make_unique<ArithLogic>(opensmt::Logic_t::QF_LRA);
+        encodedNetworkPtr = nullptr;
+        samplesInLogicCount = 0;
+        realConstTerms.clear();
+    }
+    ++samplesInLogicCount;
+
     solver = std::make_unique<MainSolver>(*logic, *config, "verifier");
-    inputVars.clear();
-    outputVars.clear();
+    guardTerms.clear();
+    guardVarsCount = 0;
 
     // resetSample() is called by Verifier
 }
 
 UnsatCore OpenSMTVerifier::OpenSMTImpl::getUnsatCore() const {
+    spexplain::Profile::Scope const profileScope{"opensmt::getUnsatCore"};
     auto const unsatCore = solver->getUnsatCore();
     auto const & unsatCoreTerms = unsatCore->getTerms();
 
@@ -3,6 +3,8 @@
 
 #include <verifiers/UnsatCoreVerifier.h>
 
+#include <spexplain/network/BoundPropagation.h>
+
 #include <memory>
 
 namespace opensmt {
@@ -21,6 +23,10 @@ public:
     OpenSMTVerifier(OpenSMTVerifier &&) = default;
     OpenSMTVerifier & operator=(OpenSMTVerifier &&) = default;
 
+    // Asserts the phases of the ReLUs that are stable within the box of the asserted bounds of the inputs
+    // The phases are not explanation terms, hence it must not be used together with interpolation
+    void setBoundPropagation(spexplain::Network::BoundPropagation::Type);
+
     bool contains(::opensmt::PTRef const &, NodeIndex) const;
 
     std::size_t termSizeOf(::opensmt::PTRef const &) const;
@@ -39,6 +45,7 @@ public:
     void addInterval(LayerIndex layer, NodeIndex var, Float lo, Float hi, bool explanationTerm = false) override;
 
     void addClassificationConstraint(NodeIndex node, Float threshold) override;
+    void addOutputDifferenceConstraint(NodeIndex node, NodeIndex otherNode, Float threshold) override;
 
     void addConstraint(LayerIndex layer, std::vector<std::pair<NodeIndex, int>> lhs, Float rhs) override;
 
@@ -64,6 +71,9 @@ protected:
 
     Answer checkImpl() override;
 
+    void addGuardedBoundImpl(Guard, GuardedBound const &) override;
+    Answer checkAssumingImpl(std::span<Guard const>) override;
+
 private:
     class OpenSMTImpl;
     std::unique_ptr<OpenSMTImpl> pimpl;